@@ -0,0 +1,182 @@
+/**
+ * E-MOTORBIKE RENTAL APPLICATION
+ * Allocation Count Benchmark
+ *
+ * Counts heap allocations (global operator new) on the read paths. The
+ * by-value pass reads each record's string fields into strings, which is what
+ * every getter did when they returned std::string; the reference pass reads
+ * the same fields through the const string& getters. The search and
+ * statistics figures are per call through the public BookingManager API.
+ *
+ * Build (from the repository root):
+ *   g++ -O2 -Iinclude bench/alloc_benchmark.cpp src/file_loader.cpp src/snapshot.cpp \
+ *       src/string_pool.cpp src/booking.cpp src/auth.cpp src/motorbike_catalog.cpp \
+ *       src/text_index.cpp src/search_cache.cpp src/message_stream.cpp src/booking_snapshot.cpp \
+ *       src/epoch.cpp -o alloc_benchmark
+ *   or configure CMake with -DEMR_BUILD_BENCHMARKS=ON
+ * Run:
+ *   ./alloc_benchmark [motorbikes]     (default 10000, written under bench_data/)
+ */
+
+#include "booking.h"
+#include "auth.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define makeDirectory(path) _mkdir(path)
+#else
+#include <unistd.h>
+#define makeDirectory(path) mkdir(path, 0755)
+#endif
+
+using namespace std;
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* memory = malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+static void writeMotorbikesFile(const string& filename, size_t count) {
+    ofstream file(filename);
+    file << "# Motorbike Data Format: motorbikeId|ownerUsername|brand|model|color|size|plateNo|pricePerDay|location|isAvailable|rating|description|availableStartDate|availableEndDate|minRenterRating|isListed\n";
+    const char* cities[] = {"HCMC", "Hanoi"};
+    for (size_t i = 0; i < count; i++) {
+        file << "MB" << (i + 1) << "|owner_account_" << i << "|VinFast|Klara S|Red|50cc|59A1-"
+             << (10000 + i % 90000) << "|" << (20 + i % 40) << "|" << cities[i % 2] << "|1|4|"
+             << "VinFast Klara S - Red 50cc Electric Scooter|01/09/2025|31/12/2025|" << (i % 4) << "|1\n";
+    }
+}
+
+static void writeAccountFile(const string& filename) {
+    ofstream file(filename);
+    file << "# Account Data Format: username|password|role|fullName|email|phoneNumber|idType|idNumber|licenseNumber|licenseExpiry|creditPoints|rating\n";
+    file << "renter|Renter123!|member|Bench Renter|renter@example.com|0900000000|Passport|P000000001|DL000001|31/12/2030|1000|5\n";
+}
+
+// The fields a listing screen reads from each motorbike
+static size_t byValuePass(const vector<const Motorbike*>& fleet) {
+    size_t bytes = 0;
+    for (const Motorbike* motorbike : fleet) {
+        string id = motorbike->getMotorbikeId();
+        string owner = motorbike->getOwnerUsername();
+        string brand = motorbike->getBrand();
+        string model = motorbike->getModel();
+        string plate = motorbike->getPlateNo();
+        string location = motorbike->getLocation();
+        string description = motorbike->getDescription();
+        bytes += id.size() + owner.size() + brand.size() + model.size() + plate.size() +
+                 location.size() + description.size();
+    }
+    return bytes;
+}
+
+static size_t referencePass(const vector<const Motorbike*>& fleet) {
+    size_t bytes = 0;
+    for (const Motorbike* motorbike : fleet) {
+        bytes += motorbike->getMotorbikeId().size() + motorbike->getOwnerUsername().size() +
+                 motorbike->getBrand().size() + motorbike->getModel().size() +
+                 motorbike->getPlateNo().size() + motorbike->getLocation().size() +
+                 motorbike->getDescription().size();
+    }
+    return bytes;
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? stoul(argv[1]) : 10000;
+
+    makeDirectory("bench_data");
+    makeDirectory("bench_data/data");
+    if (chdir("bench_data") != 0) {
+        cout << "Cannot enter bench_data directory." << endl;
+        return 1;
+    }
+    writeMotorbikesFile("data/motorbikes.txt", count);
+    writeAccountFile("data/account.txt");
+    ofstream("data/bookings.txt") << "# Booking Data Format\n";
+    ofstream("data/reviews.txt") << "# Review Data Format\n";
+    remove("data/bookings.log");
+
+    Auth auth;
+    BookingManager manager;
+    vector<const Motorbike*> fleet;
+    for (const Motorbike& motorbike : manager.viewMotorbikes()) {
+        fleet.push_back(&motorbike);
+    }
+    cout << "Loaded " << fleet.size() << " motorbikes" << endl;
+
+    size_t before = allocations;
+    size_t byValueBytes = byValuePass(fleet);
+    size_t byValue = allocations - before;
+
+    before = allocations;
+    size_t referenceBytes = referencePass(fleet);
+    size_t byReference = allocations - before;
+    if (byValueBytes != referenceBytes) {
+        cout << "Mismatch between passes!" << endl;
+        return 1;
+    }
+
+    cout << "Field pass, by-value getters:     " << byValue << " allocations ("
+         << static_cast<double>(byValue) / fleet.size() << " per motorbike)" << endl;
+    cout << "Field pass, reference getters:    " << byReference << " allocations ("
+         << static_cast<double>(byReference) / fleet.size() << " per motorbike)" << endl;
+
+    // Public search paths; the first call fills the search cache
+    const int runs = 10;
+    manager.searchMotorbikes("12/10/2025", "HCMC", "renter", auth);
+    before = allocations;
+    size_t results = 0;
+    for (int run = 0; run < runs; run++) {
+        results = manager.searchMotorbikes("12/10/2025", "HCMC", "renter", auth).size();
+    }
+    cout << "searchMotorbikes (" << results << " results): "
+         << (allocations - before) / runs << " allocations per call" << endl;
+
+    SearchRequest request;
+    request.startDate = "12/10/2025";
+    request.city = "HCMC";
+    before = allocations;
+    for (int run = 0; run < runs; run++) {
+        results = manager.searchMotorbikesPage(request, "renter", auth).results.size();
+    }
+    cout << "searchMotorbikesPage (" << results << " results): "
+         << (allocations - before) / runs << " allocations per call" << endl;
+
+    // The motorbike pass of the admin statistics screen, copied vs viewed
+    before = allocations;
+    size_t listed = 0;
+    for (const Motorbike& motorbike : manager.getAllMotorbikes()) {
+        listed += motorbike.getIsListed();
+    }
+    size_t copied = allocations - before;
+    before = allocations;
+    listed = 0;
+    for (const Motorbike& motorbike : manager.viewMotorbikes()) {
+        listed += motorbike.getIsListed();
+    }
+    cout << "Statistics pass, getAllMotorbikes: " << copied << " allocations" << endl;
+    cout << "Statistics pass, viewMotorbikes:   " << (allocations - before) << " allocations ("
+         << listed << " listed)" << endl;
+    return 0;
+}
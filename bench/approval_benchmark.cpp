@@ -0,0 +1,268 @@
+/**
+ * E-MOTORBIKE RENTAL APPLICATION
+ * Concurrent Approval Benchmark
+ *
+ * Stress test for booking requests and approvals made from several threads
+ * at once. Every thread walks the same list of renters. For each renter it
+ * requests a motorbike and approves the request as its owner. Most requests
+ * go to motorbikes that only that thread uses, so they should not wait for
+ * each other. Every 4th request goes to one of a few hot motorbikes that all
+ * threads compete for, and a renter's requests from different threads
+ * compete for the same credit points. Each mode runs with 1, 2, 4, ...
+ * threads:
+ *   global   every call runs under one mutex (the single-thread contract)
+ *   striped  calls are made directly and rely on BookingManager's own
+ *            per-motorbike and per-user locks
+ *   queue    calls are submitted to a CommandQueue and the thread waits for
+ *            each result; one apply thread group-commits whatever the
+ *            threads have submitted meanwhile
+ * After each run the final state is checked: no motorbike may have two
+ * approved bookings whose periods overlap, and every renter's credit points
+ * must equal the starting balance minus their approved bookings. The same
+ * checks then run on the data files and journals loaded afresh, as after a
+ * crash.
+ *
+ * Build: configure CMake with -DEMR_BUILD_BENCHMARKS=ON; add -DEMR_TSAN=ON
+ *        to run it under ThreadSanitizer
+ * Run:
+ *   ./approval_benchmark [motorbikes] [renters] [max threads]
+ *   (defaults 4000 1000 4, data written under bench_data/)
+ */
+
+#include "booking_snapshot.h"
+#include "command_queue.h"
+#include "auth.h"
+#include "message_stream.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define makeDirectory(path) _mkdir(path)
+#else
+#include <unistd.h>
+#define makeDirectory(path) mkdir(path, 0755)
+#endif
+
+using namespace std;
+
+static const size_t HOT_MOTORBIKES = 8;
+static const double RENTER_CREDITS = 200.0;   // Enough for one or two 3-day rentals
+
+static void writeDataFiles(size_t motorbikeCount, size_t renterCount) {
+    ofstream motorbikes("data/motorbikes.txt");
+    motorbikes << "# Motorbike Data Format: motorbikeId|ownerUsername|brand|model|color|size|plateNo|pricePerDay|location|isAvailable|rating|description|availableStartDate|availableEndDate|minRenterRating|isListed\n";
+    const char* cities[] = {"HCMC", "Hanoi"};
+    for (size_t i = 0; i < motorbikeCount; i++) {
+        motorbikes << "MB" << (i + 1) << "|owner" << i << "|VinFast|Klara S|Red|50cc|59A1-"
+                   << (10000 + i % 90000) << "|" << (20 + i % 40) << "|" << cities[i % 2] << "|1|"
+                   << (1 + i % 5) << "|VinFast Klara S - Red 50cc Electric Scooter|01/09/2025|31/12/2025|"
+                   << (i % 4) << "|1\n";
+    }
+    ofstream accounts("data/account.txt");
+    accounts << "# Account Data Format: username|password|role|fullName|email|phoneNumber|idType|idNumber|licenseNumber|licenseExpiry|creditPoints|rating\n";
+    for (size_t i = 0; i < renterCount; i++) {
+        accounts << "renter" << i << "|Renter123!|member|Bench Renter|renter@example.com|0900000000|Passport|P"
+                 << (100000000 + i) << "|DL" << (100000 + i) << "|31/12/2030|" << RENTER_CREDITS << "|5\n";
+    }
+    ofstream("data/bookings.txt") << "# Booking Data Format\n";
+    ofstream("data/reviews.txt") << "# Review Data Format\n";
+    remove("data/bookings.log");
+    remove("data/account.log");
+}
+
+static string dayString(size_t day) {
+    ostringstream text;
+    text << setw(2) << setfill('0') << (1 + day % 28) << "/" << setw(2) << setfill('0')
+         << (9 + day / 28 % 4) << "/2025";
+    return text.str();
+}
+
+struct RunResult {
+    double seconds = 0.0;
+    size_t requests = 0;
+    size_t created = 0;
+    size_t approved = 0;
+    size_t doubleBookings = 0;      // Overlapping approved bookings; must stay 0
+    size_t creditMismatches = 0;    // Balances that do not add up; must stay 0
+    double commandsPerBatch = 0.0;  // Queue mode: average group commit size
+};
+
+enum class LockMode {
+    Global,
+    Striped,
+    Queue
+};
+
+// Approved bookings must not overlap on any motorbike, and each renter must
+// have paid for exactly their approved bookings
+static void checkFinalState(const BookingManager& manager, Auth& auth, size_t renterCount, RunResult& result) {
+    auto snapshot = manager.snapshot();
+    map<string, vector<pair<Date, Date>>> approvedPeriods;
+    map<string, double> spent;
+    for (const Booking& booking : snapshot->viewBookings()) {
+        if (booking.isApproved()) {
+            approvedPeriods[booking.getMotorbikeId()].push_back(make_pair(booking.getStart(), booking.getEnd()));
+            spent[booking.getRenterUsername()] += booking.getTotalCost();
+        }
+    }
+    for (auto& entry : approvedPeriods) {
+        vector<pair<Date, Date>>& periods = entry.second;
+        sort(periods.begin(), periods.end());
+        for (size_t i = 1; i < periods.size(); i++) {
+            if (!(periods[i - 1].second < periods[i].first)) {
+                result.doubleBookings++;
+            }
+        }
+    }
+    for (size_t i = 0; i < renterCount; i++) {
+        string renter = "renter" + to_string(i);
+        double balance = auth.getUserCreditPoints(renter);
+        if (balance < 0.0 || fabs(RENTER_CREDITS - spent[renter] - balance) > 1e-6) {
+            result.creditMismatches++;
+        }
+    }
+}
+
+static RunResult runApprovals(size_t motorbikeCount, size_t renterCount, size_t threadCount, LockMode mode) {
+    writeDataFiles(motorbikeCount, renterCount);
+    Auth auth;
+    BookingManager manager;
+    unique_ptr<CommandQueue> queue(mode == LockMode::Queue ? new CommandQueue(manager, auth) : nullptr);
+    bool globalLock = mode == LockMode::Global;
+    mutex globalMutex;
+    atomic<size_t> created(0);
+    atomic<size_t> approved(0);
+
+    auto started = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (size_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t]() {
+            ofstream discard;   // Never opened: every message is dropped
+            ScopedMessageStream quiet(discard);
+            size_t ownMotorbikes = motorbikeCount - HOT_MOTORBIKES;
+            size_t threadCreated = 0;
+            size_t threadApproved = 0;
+            for (size_t step = 0; step < renterCount; step++) {
+                size_t motorbike = step % 4 == 0 ? step / 4 % HOT_MOTORBIKES
+                                                 : HOT_MOTORBIKES + (t + threadCount * step) % ownMotorbikes;
+                size_t day = (step * 5 + t) % 110;
+                BookingRequest request = {"renter" + to_string(step), "MB" + to_string(motorbike + 1),
+                                          dayString(day), dayString(day + 2)};
+                string owner = "owner" + to_string(motorbike);
+
+                if (queue) {
+                    CommandResult booking = queue->submit(BookingCommand::createBooking(
+                        request.renter, request.motorbikeId, request.startDate, request.endDate)).get();
+                    if (booking.ok) {
+                        threadCreated++;
+                        if (queue->submit(BookingCommand::approveBooking(booking.bookingId, owner)).get().ok) {
+                            threadApproved++;
+                        }
+                    }
+                    continue;
+                }
+
+                unique_lock<mutex> lock(globalMutex, defer_lock);
+                if (globalLock) {
+                    lock.lock();
+                }
+                BookingResult result = manager.createBookings(vector<BookingRequest>(1, request), auth)[0];
+                if (!result.created()) {
+                    continue;
+                }
+                threadCreated++;
+                if (globalLock) {
+                    lock.unlock();
+                    lock.lock();    // Let the other threads in between the two calls
+                }
+                if (manager.approveBooking(result.bookingId, owner, auth)) {
+                    threadApproved++;
+                }
+            }
+            created += threadCreated;
+            approved += threadApproved;
+        });
+    }
+    for (thread& worker : threads) {
+        worker.join();
+    }
+
+    RunResult result;
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    result.requests = renterCount * threadCount;
+    result.created = created;
+    result.approved = approved;
+    if (queue) {
+        CommandQueue::Stats stats = queue->getStats();
+        result.commandsPerBatch = static_cast<double>(stats.commands) / max<uint64_t>(stats.batches, 1);
+        queue.reset();
+    }
+    checkFinalState(manager, auth, renterCount, result);
+
+    // Load the files again while the live state still exists, as a restart
+    // after a crash at this point would: the replayed journals must pass too
+    {
+        ofstream discard;
+        ScopedMessageStream quiet(discard);
+        Auth reloadedAuth;
+        BookingManager reloadedManager;
+        checkFinalState(reloadedManager, reloadedAuth, renterCount, result);
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    size_t motorbikeCount = argc > 1 ? stoul(argv[1]) : 4000;
+    size_t renterCount = argc > 2 ? stoul(argv[2]) : 1000;
+    size_t maxThreads = argc > 3 ? stoul(argv[3]) : 4;
+    if (motorbikeCount <= HOT_MOTORBIKES) {
+        cout << "Need more than " << HOT_MOTORBIKES << " motorbikes." << endl;
+        return 1;
+    }
+
+    makeDirectory("bench_data");
+    makeDirectory("bench_data/data");
+    if (chdir("bench_data") != 0) {
+        cout << "Cannot enter bench_data directory." << endl;
+        return 1;
+    }
+    ofstream engineLog("engine.log");
+    setMessageStream(engineLog);
+    cout << motorbikeCount << " motorbikes, " << renterCount << " renters per thread, "
+         << thread::hardware_concurrency() << " cores" << endl;
+
+    size_t failures = 0;
+    const char* modeNames[] = {"global locking", "striped locking", "command queue"};
+    for (LockMode mode : {LockMode::Global, LockMode::Striped, LockMode::Queue}) {
+        cout << modeNames[static_cast<int>(mode)] << ":" << endl;
+        for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+            RunResult result = runApprovals(motorbikeCount, renterCount, threads, mode);
+            cout << "  " << setw(3) << threads << " threads: " << setw(8) << fixed << setprecision(0)
+                 << result.requests / result.seconds << " requests/s, " << setw(6)
+                 << result.approved / result.seconds << " approvals/s (" << result.created << " created, "
+                 << result.approved << " approved), " << result.doubleBookings << " double bookings, "
+                 << result.creditMismatches << " credit mismatches";
+            if (mode == LockMode::Queue) {
+                cout << ", " << setprecision(1) << result.commandsPerBatch << " commands/commit";
+            }
+            cout << endl;
+            failures += result.doubleBookings + result.creditMismatches;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/**
+ * E-MOTORBIKE RENTAL APPLICATION
+ * Startup Load Benchmark
+ *
+ * Generates a large bookings file and compares the original
+ * getline/stringstream loader against the memory-mapped loader used by
+ * BookingManager.
+ *
+ * Build (from the repository root):
+ *   g++ -O2 -Iinclude bench/load_benchmark.cpp src/file_loader.cpp src/snapshot.cpp \
+ *       src/string_pool.cpp src/booking.cpp src/auth.cpp src/motorbike_catalog.cpp \
+ *       src/text_index.cpp src/search_cache.cpp src/message_stream.cpp src/booking_snapshot.cpp \
+ *       src/epoch.cpp -o load_benchmark
+ *   or configure CMake with -DEMR_BUILD_BENCHMARKS=ON
+ * Run:
+ *   ./load_benchmark [rows]     (default 2000000 rows, written under bench_data/)
+ */
+
+#include "booking.h"
+#include "file_loader.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define makeDirectory(path) _mkdir(path)
+#else
+#include <unistd.h>
+#define makeDirectory(path) mkdir(path, 0755)
+#endif
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+static void writeBookingsFile(const string& filename, size_t rows) {
+    ofstream file(filename);
+    file << "# Booking Data Format: bookingId|renterUsername|ownerUsername|motorbikeId|startDate|endDate|status|totalCost|brand|model|color|size|plateNo\n";
+    const char* statuses[] = {"Completed", "Rejected", "Approved", "Pending"};
+    for (size_t i = 0; i < rows; i++) {
+        file << "BK" << (i + 1) << "|renter" << (i % 50000) << "|owner" << (i % 20000)
+             << "|MB" << (i % 20000 + 1) << "|" << (i % 28 + 1 < 10 ? "0" : "") << (i % 28 + 1)
+             << "/09/2025|" << (i % 28 + 1 < 10 ? "0" : "") << (i % 28 + 1) << "/10/2025|"
+             << statuses[i % 4] << "|" << (25 + i % 100) << "|VinFast|Klara S|Red|50cc|59A1-"
+             << (10000 + i % 90000) << "\n";
+    }
+}
+
+// The loader BookingManager used before switching to MappedFile
+static vector<Booking> legacyLoadBookings(const string& filename) {
+    vector<Booking> bookings;
+    ifstream file(filename);
+    string line;
+    while (getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        line.erase(0, line.find_first_not_of(" \t\r\n"));
+        line.erase(line.find_last_not_of(" \t\r\n") + 1);
+
+        if (line.empty()) continue;
+
+        stringstream ss(line);
+        string token;
+        vector<string> tokens;
+
+        while (getline(ss, token, '|')) {
+            token.erase(0, token.find_first_not_of(" \t\r\n"));
+            token.erase(token.find_last_not_of(" \t\r\n") + 1);
+            tokens.push_back(token);
+        }
+
+        if (tokens.size() >= 13) {
+            Booking booking(tokens[0], tokens[1], tokens[2], tokens[3], tokens[4], tokens[5],
+                           tokens[6], stod(tokens[7]), tokens[8], tokens[9], tokens[10], tokens[11], tokens[12]);
+            bookings.push_back(booking);
+        }
+    }
+    return bookings;
+}
+
+static vector<Booking> mappedLoadBookings(const string& filename) {
+    vector<Booking> bookings;
+    MappedFile file(filename);
+    bookings.reserve(countLines(file.view()));
+    forEachRecord(file.view(), [&bookings](const string_view* fields, size_t count) {
+        if (count >= 13) {
+            bookings.push_back(Booking(string(fields[0]), string(fields[1]), string(fields[2]),
+                                       string(fields[3]), string(fields[4]), string(fields[5]),
+                                       string(fields[6]), parseDouble(fields[7]), string(fields[8]),
+                                       string(fields[9]), string(fields[10]), string(fields[11]),
+                                       string(fields[12])));
+        }
+    });
+    return bookings;
+}
+
+int main(int argc, char* argv[]) {
+    size_t rows = argc > 1 ? stoul(argv[1]) : 2000000;
+
+    makeDirectory("bench_data");
+    makeDirectory("bench_data/data");
+    string filename = "bench_data/data/bookings.txt";
+
+    cout << "Generating " << rows << " bookings..." << endl;
+    writeBookingsFile(filename, rows);
+
+    Clock::time_point start = Clock::now();
+    size_t legacyCount = legacyLoadBookings(filename).size();
+    double legacyMs = elapsedMs(start);
+
+    start = Clock::now();
+    size_t mappedCount = mappedLoadBookings(filename).size();
+    double mappedMs = elapsedMs(start);
+
+    // Full BookingManager start-up against the same file
+    if (chdir("bench_data") != 0) {
+        cout << "Cannot enter bench_data directory." << endl;
+        return 1;
+    }
+    remove("data/bookings.log");
+    start = Clock::now();
+    BookingManager* manager = new BookingManager();
+    double managerMs = elapsedMs(start);
+    delete manager;
+
+    cout << "Legacy getline/stringstream loader: " << legacyMs << " ms (" << legacyCount << " bookings)" << endl;
+    cout << "Memory-mapped loader:               " << mappedMs << " ms (" << mappedCount << " bookings)" << endl;
+    cout << "BookingManager start-up:            " << managerMs << " ms" << endl;
+    cout << "Speed-up: " << (mappedMs > 0 ? legacyMs / mappedMs : 0.0) << "x" << endl;
+    return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * E-MOTORBIKE RENTAL APPLICATION
+ * Search Filter Benchmark
+ *
+ * Builds a synthetic fleet and compares the per-object search filter
+ * (the checks in BookingManager::meetsSearchCriteria) against the columnar
+ * MotorbikeCatalog scan used by searchMotorbikes, then times a date-range
+ * scan that also consults the per-motorbike day-occupancy bitmaps.
+ *
+ * Build (from the repository root):
+ *   g++ -O2 -march=native -Iinclude bench/search_benchmark.cpp src/motorbike_catalog.cpp \
+ *       src/string_pool.cpp src/booking.cpp src/auth.cpp src/file_loader.cpp src/snapshot.cpp \
+ *       src/text_index.cpp src/search_cache.cpp src/message_stream.cpp src/booking_snapshot.cpp \
+ *       src/epoch.cpp -o search_benchmark
+ *   (drop -march=native to measure the scalar fallback)
+ *   or configure CMake with -DEMR_BUILD_BENCHMARKS=ON
+ * Run:
+ *   ./search_benchmark [motorbikes]     (default 1000000)
+ */
+
+#include "booking.h"
+#include "motorbike_catalog.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+static string dayString(int day) {
+    return (day < 10 ? "0" : "") + to_string(day) + "/09/2025";
+}
+
+// The per-object filter searchMotorbikes ran before the catalog
+static size_t objectScan(const vector<Motorbike>& fleet, const string& city, const string& date,
+                         double renterRating, double renterCredits) {
+    size_t matches = 0;
+    for (const Motorbike& motorbike : fleet) {
+        if (motorbike.getIsListed() && motorbike.getIsAvailable() &&
+            motorbike.getLocation() == city &&
+            motorbike.isAvailableForDate(date) &&
+            renterRating >= motorbike.getMinRenterRating() &&
+            renterCredits >= motorbike.calculateRentalCost(1)) {
+            matches++;
+        }
+    }
+    return matches;
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? stoul(argv[1]) : 1000000;
+    const char* cities[] = {"HCMC", "Hanoi"};
+    const char* sizes[] = {"50cc", "110cc", "150cc"};
+
+    cout << "Generating " << count << " motorbikes..." << endl;
+    vector<Motorbike> fleet;
+    fleet.reserve(count);
+    MotorbikeCatalog catalog;
+    catalog.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        fleet.push_back(Motorbike("MB" + to_string(i + 1), "owner" + to_string(i), "VinFast", "Klara S",
+                                  "Red", sizes[i % 3], "59A1-" + to_string(10000 + i % 90000),
+                                  20 + i % 60, cities[i % 2], i % 5 != 0, 0.0, "",
+                                  dayString(1 + i % 10), dayString(15 + i % 15), (i % 4) * 1.0,
+                                  i % 7 != 0));
+        catalog.set(i, fleet.back());
+    }
+
+    string city = "HCMC";
+    string date = "12/09/2025";
+    double renterRating = 2.5;
+    double renterCredits = 60;
+
+    Clock::time_point start = Clock::now();
+    size_t objectMatches = objectScan(fleet, city, date, renterRating, renterCredits);
+    double objectMs = elapsedMs(start);
+
+    CatalogQuery query;
+    query.cityId = fieldPool().find(city);
+    query.startDay = Date::parse(date).dayNumber();
+    query.endDay = query.startDay;
+    query.rentalDays = 1;
+    query.renterRating = renterRating;
+    query.renterCredits = renterCredits;
+
+    vector<uint64_t> selection;
+    const int runs = 20;
+    size_t catalogMatches = 0;
+    start = Clock::now();
+    for (int run = 0; run < runs; run++) {
+        catalogMatches = catalog.select(query, selection);
+    }
+    double catalogMs = elapsedMs(start) / runs;
+
+    const char* kernel = MotorbikeCatalog::usesAVX2() ? "AVX2" : "scalar";
+    cout << "Per-object filter:        " << objectMs << " ms (" << objectMatches << " matches)" << endl;
+    cout << "Catalog select (" << kernel << "): " << catalogMs << " ms (" << catalogMatches << " matches)" << endl;
+    if (objectMatches != catalogMatches) {
+        cout << "Mismatch between filters!" << endl;
+        return 1;
+    }
+    cout << "Speed-up: " << (catalogMs > 0 ? objectMs / catalogMs : 0.0) << "x" << endl;
+
+    // Every third motorbike has an approved booking on 10-12/09
+    Date bookedStart = Date::parse("10/09/2025");
+    for (size_t i = 0; i < count; i += 3) {
+        catalog.setOccupied(i, bookedStart.dayNumber(), bookedStart.dayNumber() + 2, true);
+    }
+    query.startDay = Date::parse("08/09/2025").dayNumber();
+    query.endDay = Date::parse("14/09/2025").dayNumber();
+    query.rentalDays = 7;
+    query.renterCredits = 400;
+    query.requireFree = true;
+
+    size_t expected = 0;
+    for (size_t i = 0; i < count; i++) {
+        const Motorbike& motorbike = fleet[i];
+        if (i % 3 != 0 && motorbike.getIsListed() && motorbike.getIsAvailable() &&
+            motorbike.getLocation() == city &&
+            motorbike.isAvailableForDateRange(Date(query.startDay), Date(query.endDay)) &&
+            renterRating >= motorbike.getMinRenterRating() &&
+            query.renterCredits >= motorbike.calculateRentalCost(7)) {
+            expected++;
+        }
+    }
+
+    start = Clock::now();
+    for (int run = 0; run < runs; run++) {
+        catalogMatches = catalog.select(query, selection);
+    }
+    double rangeMs = elapsedMs(start) / runs;
+    cout << "Date-range select with occupancy: " << rangeMs << " ms (" << catalogMatches << " matches)" << endl;
+    if (catalogMatches != expected) {
+        cout << "Mismatch in date-range filter!" << endl;
+        return 1;
+    }
+    return 0;
+}
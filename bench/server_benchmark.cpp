@@ -0,0 +1,246 @@
+/**
+ * E-MOTORBIKE RENTAL APPLICATION
+ * Booking Server Benchmark
+ *
+ * Starts a BookingServer on a synthetic data set and connects many clients
+ * to it over its Unix domain socket. Every client logs in as its own renter,
+ * pipelines rounds of search requests, then books one motorbike. Reports
+ * requests per second for each phase.
+ *
+ * Build: configure CMake with -DEMR_BUILD_BENCHMARKS=ON (Linux only)
+ * Run:
+ *   ./server_benchmark [clients] [rounds] [pipeline depth] [client threads]
+ *   (defaults 2000 50 8 4, data written under bench_data/)
+ */
+
+#include "booking_server.h"
+#include "auth.h"
+#include "message_stream.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static const char* SOCKET_PATH = "server.sock";
+
+static double elapsedSeconds(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void writeDataFiles(size_t clients) {
+    ofstream motorbikes("data/motorbikes.txt");
+    motorbikes << "# Motorbike Data Format: motorbikeId|ownerUsername|brand|model|color|size|plateNo|pricePerDay|location|isAvailable|rating|description|availableStartDate|availableEndDate|minRenterRating|isListed\n";
+    const char* cities[] = {"HCMC", "Hanoi"};
+    for (size_t i = 0; i < clients * 5; i++) {
+        motorbikes << "MB" << (i + 1) << "|owner_account_" << i << "|VinFast|Klara S|Red|50cc|59A1-"
+                   << (10000 + i % 90000) << "|" << (20 + i % 40) << "|" << cities[i % 2] << "|1|4|"
+                   << "VinFast Klara S - Red 50cc Electric Scooter|01/09/2025|31/12/2025|" << (i % 4) << "|1\n";
+    }
+    ofstream accounts("data/account.txt");
+    accounts << "# Account Data Format: username|password|role|fullName|email|phoneNumber|idType|idNumber|licenseNumber|licenseExpiry|creditPoints|rating\n";
+    for (size_t i = 0; i < clients; i++) {
+        accounts << "renter" << i << "|Renter123!|member|Bench Renter|renter@example.com|0900000000|Passport|P"
+                 << (100000000 + i) << "|DL" << (100000 + i) << "|31/12/2030|1000|5\n";
+    }
+    ofstream("data/bookings.txt") << "# Booking Data Format\n";
+    ofstream("data/reviews.txt") << "# Review Data Format\n";
+    remove("data/bookings.log");
+}
+
+static int connectClient() {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    snprintf(address.sun_path, sizeof(address.sun_path), "%s", SOCKET_PATH);
+    if (fd >= 0 && connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool sendAll(int fd, const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t written = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+static bool receiveAll(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t received = recv(fd, data, size, 0);
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+// Reads one response and returns its status, or -1 if the connection failed
+static int receiveResponse(int fd, string& payload) {
+    char header[FRAME_HEADER_SIZE];
+    if (!receiveAll(fd, header, sizeof(header))) {
+        return -1;
+    }
+    payload.resize(frameLength(header, sizeof(header)));
+    if (payload.empty() || !receiveAll(fd, &payload[0], payload.size())) {
+        return -1;
+    }
+    return static_cast<uint8_t>(payload[0]);
+}
+
+struct ClientThread {
+    vector<int> fds;
+    size_t first = 0;           // Index of fds[0] among all clients
+    size_t failures = 0;
+    size_t matches = 0;
+};
+
+// Sends requests(i) on each connection, then reads all the responses; with
+// countMatches the responses are Search results
+template <typename Requests>
+static void exchange(ClientThread& client, size_t perConnection, Requests requests, bool countMatches = false) {
+    string out;
+    string payload;
+    for (size_t i = 0; i < client.fds.size(); i++) {
+        out.clear();
+        requests(client.first + i, out);
+        client.failures += !sendAll(client.fds[i], out);
+    }
+    for (size_t i = 0; i < client.fds.size(); i++) {
+        for (size_t response = 0; response < perConnection; response++) {
+            int status = receiveResponse(client.fds[i], payload);
+            if (status != static_cast<int>(ResponseStatus::Ok)) {
+                client.failures++;
+            } else if (countMatches) {
+                FrameReader reader(string_view(payload).substr(1));
+                client.matches += reader.u32();
+            }
+        }
+    }
+}
+
+template <typename Phase>
+static double runPhase(vector<ClientThread>& clients, Phase phase) {
+    Clock::time_point start = Clock::now();
+    vector<thread> threads;
+    for (ClientThread& client : clients) {
+        threads.emplace_back([&client, &phase]() { phase(client); });
+    }
+    for (thread& worker : threads) {
+        worker.join();
+    }
+    return elapsedSeconds(start);
+}
+
+int main(int argc, char* argv[]) {
+    size_t clientCount = argc > 1 ? stoul(argv[1]) : 2000;
+    size_t rounds = argc > 2 ? stoul(argv[2]) : 50;
+    size_t depth = argc > 3 ? stoul(argv[3]) : 8;
+    size_t threadCount = argc > 4 ? stoul(argv[4]) : 4;
+
+    mkdir("bench_data", 0755);
+    mkdir("bench_data/data", 0755);
+    if (chdir("bench_data") != 0) {
+        cout << "Cannot enter bench_data directory." << endl;
+        return 1;
+    }
+    writeDataFiles(clientCount);
+
+    ofstream engineLog("server.log");
+    setMessageStream(engineLog);
+    Auth auth;
+    BookingManager manager;
+    EventLoop loop;
+    BookingServer server(loop, auth, manager);
+    if (!server.listenUnix(SOCKET_PATH)) {
+        return 1;
+    }
+    thread serverThread([&loop]() { loop.run(); });
+
+    vector<ClientThread> clients(threadCount);
+    for (size_t i = 0; i < clientCount; i++) {
+        int fd = connectClient();
+        if (fd < 0) {
+            cout << "Connect failed after " << i << " clients (raise ulimit -n?)" << endl;
+            loop.stop();
+            serverThread.join();
+            return 1;
+        }
+        // Each thread drives a contiguous block of clients
+        ClientThread& client = clients[i * threadCount / clientCount];
+        if (client.fds.empty()) {
+            client.first = i;
+        }
+        client.fds.push_back(fd);
+    }
+    cout << "Connected " << clientCount << " clients on " << threadCount << " threads" << endl;
+
+    double seconds = runPhase(clients, [](ClientThread& client) {
+        exchange(client, 1, [](size_t id, string& out) {
+            FrameWriter(out).u8(static_cast<uint8_t>(Opcode::Login))
+                .str("renter" + to_string(id)).str("Renter123!").finish();
+        });
+    });
+    cout << "Login:  " << clientCount / seconds << " requests/s" << endl;
+
+    seconds = runPhase(clients, [rounds, depth](ClientThread& client) {
+        for (size_t round = 0; round < rounds; round++) {
+            exchange(client, depth, [round, depth](size_t id, string& out) {
+                for (size_t request = 0; request < depth; request++) {
+                    FrameWriter(out).u8(static_cast<uint8_t>(Opcode::Search))
+                        .str(to_string(10 + (id + round + request) % 18) + "/10/2025").str("")
+                        .str((id + request) % 2 ? "Hanoi" : "HCMC")
+                        .u8(static_cast<uint8_t>(SearchSortKey::Price)).u32(10)
+                        .u8(0).f64(0.0).u32(0)
+                        .finish();
+                }
+            }, true);
+        }
+    });
+    size_t searches = clientCount * rounds * depth;
+    cout << "Search: " << searches / seconds << " requests/s (" << searches << " requests, depth "
+         << depth << ")" << endl;
+
+    seconds = runPhase(clients, [](ClientThread& client) {
+        exchange(client, 1, [](size_t id, string& out) {
+            FrameWriter(out).u8(static_cast<uint8_t>(Opcode::Book))
+                .str("MB" + to_string(id + 1)).str("10/11/2025").str("12/11/2025").finish();
+        });
+    });
+    cout << "Book:   " << clientCount / seconds << " requests/s" << endl;
+
+    size_t failures = 0;
+    size_t matches = 0;
+    for (ClientThread& client : clients) {
+        failures += client.failures;
+        matches += client.matches;
+        for (int fd : client.fds) {
+            close(fd);
+        }
+    }
+    loop.stop();
+    serverThread.join();
+    SocketServer::Stats stats = server.getStats();
+    cout << "Server handled " << stats.requests << " requests, " << failures << " failed, "
+         << matches << " total matches reported" << endl;
+    return failures == 0 ? 0 : 1;
+}
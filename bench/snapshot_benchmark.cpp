@@ -0,0 +1,226 @@
+/**
+ * E-MOTORBIKE RENTAL APPLICATION
+ * Snapshot Read Benchmark
+ *
+ * Stress test for concurrent reads while one writer keeps changing bookings.
+ * A writer thread creates booking requests in batches, then approves,
+ * completes or rejects them, without pausing. Each approval rewrites
+ * motorbikes.txt. Meanwhile, 1, 2, 4, ... reader threads (up to the core
+ * count) run paged searches and booking-list reads. Each mode runs with
+ * every thread count:
+ *   mutex     readers call BookingManager under the writer's mutex
+ *   snapshot  readers use BookingManager::snapshot() and take no lock
+ * The benchmark reports reads per second, writes per second and reads per
+ * second per reader thread. It also checks that every reader thread sees
+ * snapshot versions that never go backwards.
+ *
+ * Build: configure CMake with -DEMR_BUILD_BENCHMARKS=ON
+ * Run:
+ *   ./snapshot_benchmark [motorbikes] [seconds per run] [max readers]
+ *   (defaults 20000 2 = core count, data written under bench_data/)
+ */
+
+#include "booking_snapshot.h"
+#include "auth.h"
+#include "message_stream.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define makeDirectory(path) _mkdir(path)
+#else
+#include <unistd.h>
+#define makeDirectory(path) mkdir(path, 0755)
+#endif
+
+using namespace std;
+
+static const size_t RENTERS = 2000;
+static const double RENTER_RATING = 5.0;
+static const double RENTER_CREDITS = 100000.0;   // Snapshot readers pass these instead of asking Auth
+
+static void writeDataFiles(size_t motorbikeCount) {
+    ofstream motorbikes("data/motorbikes.txt");
+    motorbikes << "# Motorbike Data Format: motorbikeId|ownerUsername|brand|model|color|size|plateNo|pricePerDay|location|isAvailable|rating|description|availableStartDate|availableEndDate|minRenterRating|isListed\n";
+    const char* cities[] = {"HCMC", "Hanoi"};
+    for (size_t i = 0; i < motorbikeCount; i++) {
+        motorbikes << "MB" << (i + 1) << "|owner" << i << "|VinFast|Klara S|Red|50cc|59A1-"
+                   << (10000 + i % 90000) << "|" << (20 + i % 40) << "|" << cities[i % 2] << "|1|"
+                   << (1 + i % 5) << "|VinFast Klara S - Red 50cc Electric Scooter|01/09/2025|31/12/2025|"
+                   << (i % 4) << "|1\n";
+    }
+    ofstream accounts("data/account.txt");
+    accounts << "# Account Data Format: username|password|role|fullName|email|phoneNumber|idType|idNumber|licenseNumber|licenseExpiry|creditPoints|rating\n";
+    for (size_t i = 0; i < RENTERS; i++) {
+        accounts << "renter" << i << "|Renter123!|member|Bench Renter|renter@example.com|0900000000|Passport|P"
+                 << (100000000 + i) << "|DL" << (100000 + i) << "|31/12/2030|" << RENTER_CREDITS << "|" << RENTER_RATING << "\n";
+    }
+    ofstream("data/bookings.txt") << "# Booking Data Format\n";
+    ofstream("data/reviews.txt") << "# Review Data Format\n";
+    remove("data/bookings.log");
+}
+
+static string dayString(size_t day) {
+    ostringstream text;
+    text << setw(2) << setfill('0') << (1 + day % 28) << "/" << setw(2) << setfill('0')
+         << (9 + day / 28 % 4) << "/2025";
+    return text.str();
+}
+
+struct RunResult {
+    double readsPerSecond = 0.0;
+    double writesPerSecond = 0.0;
+    double resultsPerRead = 0.0;
+    size_t staleVersions = 0;   // Snapshot versions that went backwards; must stay 0
+};
+
+// Reads and writes for `seconds`. The writer alternates between batches of
+// new requests and deciding on them (approve + complete, or reject); each
+// reader runs paged searches and reads one renter's bookings every 16th time.
+static RunResult runMixedLoad(BookingManager& manager, Auth& auth, size_t readers, double seconds,
+                              bool useSnapshot) {
+    mutex engineMutex;
+    atomic<bool> running(true);
+    atomic<size_t> reads(0);
+    atomic<size_t> matches(0);
+    atomic<size_t> staleVersions(0);
+    size_t writes = 0;
+
+    thread writer([&]() {
+        size_t round = 0;
+        while (running.load(memory_order_relaxed)) {
+            vector<BookingRequest> batch;
+            for (size_t i = 0; i < 16; i++) {
+                size_t renter = (round * 16 + i) % RENTERS;
+                size_t day = round * 7 + i * 3;
+                batch.push_back({"renter" + to_string(renter), "MB" + to_string(1 + (round * 131 + i * 17) % 2000),
+                                 dayString(day), dayString(day + 1)});
+            }
+            vector<BookingResult> results;
+            {
+                lock_guard<mutex> lock(engineMutex);
+                results = manager.createBookings(batch, auth);
+            }
+            writes++;
+            for (size_t i = 0; i < results.size(); i++) {
+                if (!results[i].created()) {
+                    continue;
+                }
+                // Motorbike MBn belongs to owner(n - 1)
+                string owner = "owner" + to_string(stoul(batch[i].motorbikeId.substr(2)) - 1);
+                lock_guard<mutex> lock(engineMutex);
+                if (i % 4 == 0 && manager.approveBooking(results[i].bookingId, owner, auth)) {
+                    manager.completeRental(results[i].bookingId, batch[i].renter);
+                    writes += 2;
+                } else if (manager.rejectBooking(results[i].bookingId, owner)) {
+                    writes++;
+                }
+            }
+            round++;
+        }
+    });
+
+    vector<thread> threads;
+    for (size_t r = 0; r < readers; r++) {
+        threads.emplace_back([&, r]() {
+            size_t done = 0;
+            size_t found = 0;
+            uint64_t lastVersion = 0;
+            SearchRequest request;
+            request.limit = 10;
+            while (running.load(memory_order_relaxed)) {
+                request.city = (done + r) % 2 ? "Hanoi" : "HCMC";
+                request.startDate = dayString(done % 100);
+                request.endDate = done % 3 ? dayString(done % 100 + 2) : "";
+                request.sortKey = static_cast<SearchSortKey>(done % 3);
+                string renter = "renter" + to_string((done * 7 + r) % RENTERS);
+                if (useSnapshot) {
+                    auto snapshot = manager.snapshot();
+                    if (snapshot->getVersion() < lastVersion) {
+                        staleVersions++;
+                    }
+                    lastVersion = snapshot->getVersion();
+                    found += snapshot->searchMotorbikesPage(request, RENTER_RATING, RENTER_CREDITS).results.size();
+                    if (done % 16 == 0) {
+                        snapshot->forEachUserBooking(renter, [&](const Booking&) { found++; });
+                    }
+                } else {
+                    lock_guard<mutex> lock(engineMutex);
+                    found += manager.searchMotorbikesPage(request, renter, auth).results.size();
+                    if (done % 16 == 0) {
+                        manager.forEachUserBooking(renter, [&](const Booking&) { found++; });
+                    }
+                }
+                done++;
+            }
+            reads += done;
+            matches += found;
+        });
+    }
+
+    this_thread::sleep_for(chrono::duration<double>(seconds));
+    running = false;
+    for (thread& reader : threads) {
+        reader.join();
+    }
+    writer.join();
+
+    RunResult result;
+    result.readsPerSecond = reads / seconds;
+    result.writesPerSecond = writes / seconds;
+    result.resultsPerRead = reads ? static_cast<double>(matches) / reads : 0.0;
+    result.staleVersions = staleVersions;
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    size_t motorbikeCount = argc > 1 ? stoul(argv[1]) : 20000;
+    double seconds = argc > 2 ? stod(argv[2]) : 2.0;
+    size_t maxReaders = argc > 3 ? stoul(argv[3]) : max(1u, thread::hardware_concurrency());
+
+    makeDirectory("bench_data");
+    makeDirectory("bench_data/data");
+    if (chdir("bench_data") != 0) {
+        cout << "Cannot enter bench_data directory." << endl;
+        return 1;
+    }
+    writeDataFiles(motorbikeCount);
+
+    ofstream engineLog("engine.log");
+    setMessageStream(engineLog);
+    Auth auth;
+    BookingManager manager;
+    cout << motorbikeCount << " motorbikes, " << RENTERS << " renters, " << seconds << " s per run, "
+         << thread::hardware_concurrency() << " cores" << endl;
+
+    size_t failures = 0;
+    for (bool useSnapshot : {false, true}) {
+        cout << (useSnapshot ? "snapshot" : "mutex") << " reads:" << endl;
+        double single = 0.0;
+        for (size_t readers = 1; readers <= maxReaders; readers *= 2) {
+            RunResult result = runMixedLoad(manager, auth, readers, seconds, useSnapshot);
+            if (readers == 1) {
+                single = result.readsPerSecond;
+            }
+            cout << "  " << setw(3) << readers << " readers: " << setw(10) << fixed << setprecision(0)
+                 << result.readsPerSecond << " reads/s (" << setprecision(2)
+                 << result.readsPerSecond / max(single, 1.0) << "x), " << setprecision(0)
+                 << result.readsPerSecond / readers << " per reader, " << result.writesPerSecond
+                 << " writes/s, " << setprecision(1) << result.resultsPerRead << " results/read" << endl;
+            failures += result.staleVersions;
+        }
+    }
+    cout << "Stale snapshot versions seen: " << failures << endl;
+    return failures == 0 ? 0 : 1;
+}
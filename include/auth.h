@@ -3,7 +3,17 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <deque>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include "string_pool.h"
+#include "record_view.h"
+#include "data_lock.h"
+#include "journal.h"
 
 using namespace std;
 
@@ -15,11 +25,11 @@ class User {
 private:
     string username;
     string password;
-    string role;
+    uint32_t roleId;   // Interned in fieldPool()
     string fullName;
     string email;
     string phoneNumber;
-    string idType; // "Citizen ID" or "Passport"
+    uint32_t idTypeId; // "Citizen ID" or "Passport", interned in fieldPool()
     string idNumber;
     string licenseNumber; // Optional
     string licenseExpiry; // Optional
@@ -27,27 +37,35 @@ private:
     double rating;
 
 public:
+    // Pool ids of the two roles
+    static const uint32_t MEMBER;
+    static const uint32_t ADMIN;
+
     // Constructor
-    User(const string& username = "", const string& password = "", 
-         const string& role = "member", const string& fullName = "",
-         const string& email = "", const string& phone = "",
-         const string& idType = "", const string& idNumber = "",
-         const string& licenseNumber = "", const string& licenseExpiry = "",
+    // Owned strings are taken by value and moved in; role and idType are interned
+    User(string username = "", string password = "", 
+         string_view role = "member", string fullName = "",
+         string email = "", string phone = "",
+         string_view idType = "", string idNumber = "",
+         string licenseNumber = "", string licenseExpiry = "",
          double creditPoints = 20.0, double rating = 3.0);
 
     // Getters
-    string getUsername() const { return username; }
-    string getPassword() const { return password; }
-    string getRole() const { return role; }
-    string getFullName() const { return fullName; }
-    string getEmail() const { return email; }
-    string getPhoneNumber() const { return phoneNumber; }
-    string getIdType() const { return idType; }
-    string getIdNumber() const { return idNumber; }
-    string getLicenseNumber() const { return licenseNumber; }
-    string getLicenseExpiry() const { return licenseExpiry; }
+    const string& getUsername() const { return username; }
+    const string& getPassword() const { return password; }
+    const string& getRole() const { return fieldPool().str(roleId); }
+    uint32_t getRoleId() const { return roleId; }
+    const string& getFullName() const { return fullName; }
+    const string& getEmail() const { return email; }
+    const string& getPhoneNumber() const { return phoneNumber; }
+    const string& getIdType() const { return fieldPool().str(idTypeId); }
+    const string& getIdNumber() const { return idNumber; }
+    const string& getLicenseNumber() const { return licenseNumber; }
+    const string& getLicenseExpiry() const { return licenseExpiry; }
     double getCreditPoints() const { return creditPoints; }
     double getRating() const { return rating; }
+    bool isMember() const { return roleId == MEMBER; }
+    bool isAdmin() const { return roleId == ADMIN; }
 
     // Setters
     void setFullName(const string& name) { fullName = name; }
@@ -62,13 +80,46 @@ public:
 // Simple Auth class
 class Auth {
 private:
-    vector<User> users;
+    DataLock dataLock;                       // First: nothing is loaded or saved without it
+    deque<User> users;                       // deque so User* handles survive growth
+    unordered_map<string, size_t> userIndex; // username -> slot in users
     User* currentUser;
     string accountFilename;
     
+    // Credit balances may change from several threads at once. Each user's
+    // balance is guarded by one stripe of creditLocks; a thread holds at most
+    // one stripe, and takes it last, after any BookingManager lock.
+    static const size_t CREDIT_LOCK_STRIPES = 64;
+    mutable array<mutex, CREDIT_LOCK_STRIPES> creditLocks;
+    unique_lock<mutex> creditLock(const string& username) const; // None while a group commit is open
+    
+    // Every credit change is numbered in the order it is applied and logged
+    // as a K record holding the user's new balance. Standalone changes go to
+    // creditJournal (account.log); a booking approval's charge, and every
+    // change of a group commit, go into the booking journal together with
+    // the booking records they belong to.
+    // account.txt records the last change it contains, and loading applies
+    // the newer K records of both journals on top of it.
+    Journal creditJournal;
+    string bookingJournalFilename;
+    mutex accountFileMutex;                 // account.txt rewrites, one at a time
+    atomic<uint64_t> creditChanges;
+    atomic<uint64_t> savedCreditChanges;    // Last change contained in account.txt
+    static const uint64_t CREDIT_SAVE_THRESHOLD = 500;
+    bool groupCommitOpen;
+    string groupCredits;            // K records held back by the open group commit
+    
     // File I/O methods
     void loadUsers();
-    void saveUsers();
+    int replayCredits();
+    bool logCreditChanges(const string& records, int count);
+    bool foldCredits();
+    bool writeUsers();
+    
+    // Username index helpers
+    bool putUser(User user);
+    User* findUser(const string& username);
+    const User* findUser(const string& username) const;
 
 public:
     // Constructor
@@ -76,16 +127,28 @@ public:
     
     // Destructor
     ~Auth();
+    
+    // False when another process holds data/.lock: nothing was loaded and
+    // nothing is saved; the caller should exit
+    bool hasDataLock() const { return dataLock.isHeld(); }
 
-    // Core authentication methods
-    bool login();
-    bool adminLogin();
-    bool registerUser();
+    // Core authentication methods; credentials are passed in, the console
+    // prompts live in UIAuth
+    bool login(const string& username, const string& password);
+    bool adminLogin(const string& username, const string& password);
+    
+    // The user if the password matches and their role is role ("member" or
+    // "admin"), else nullptr. Only looks the user up: no current user is set
+    // and nothing is printed, so servers can check each request's credentials.
+    const User* checkCredentials(const string& username, const string& password, const string& role) const;
+    bool registerUser(const string& username, const string& password, const string& fullName,
+                      const string& email, const string& phone, const string& idType,
+                      const string& idNumber, const string& licenseNumber = "",
+                      const string& licenseExpiry = "");
     void logout();
     User* getCurrentUser();
     
     // User management
-    string hidePassword();
     bool validateEmail(const string& email);
     bool validatePhoneNumber(const string& phone);
     bool validatePassword(const string& password);
@@ -93,8 +156,38 @@ public:
                       const string& email, const string& phoneNumber);
     bool changePassword(const string& username, const string& oldPassword, 
                        const string& newPassword);
+    
+    // Credit changes and getUserCreditPoints are safe to call from several
+    // threads at once; the rest of Auth stays on one thread. A credit change
+    // returns false when the user is unknown, the points are short or the
+    // change could not be written to account.log.
     bool topUpCreditPoints(const string& username, double amount);
     bool deductCreditPoints(const string& username, double amount);
+    
+    // Deducts a booking approval's cost without logging it: record receives
+    // the K record, which the caller journals with the approval. The user's
+    // credit lock stays held in hold until then, so no account.txt rewrite
+    // can contain the charge before the approval is durable.
+    bool chargeCreditPoints(const string& username, double amount, unique_lock<mutex>& hold, string& record);
+    
+    // K record text, "K|change|username|creditPoints"
+    static string formatCreditRecord(uint64_t change, const string& username, double creditPoints);
+    static bool parseCreditRecord(string_view line, uint64_t& change, string& username, double& creditPoints);
+    
+    // Rewrites account.txt, which makes the account.log records up to that
+    // point redundant and drops them. saveCreditsIfDue does so only once
+    // enough credit changes have been logged since the last rewrite; call
+    // either with no credit lock held.
+    void saveUsers();
+    void saveCreditsIfDue();
+    uint64_t getSavedCreditChanges() const { return savedCreditChanges.load(); }
+    
+    // Group commit, opened and closed by BookingManager's: until
+    // endGroupCommit, credit changes take no credit lock and their K records
+    // are held back. endGroupCommit returns those records for the booking
+    // journal to write with the rest of the batch.
+    void beginGroupCommit();
+    string endGroupCommit();
     void displayProfile(const string& username, BookingManager* bookingManager = nullptr);
     
     // User data access methods
@@ -102,8 +195,11 @@ public:
     double getUserCreditPoints(const string& username);
     string getUserLicenseExpiry(const string& username);
     
+    const User* getUser(const string& username) const { return findUser(username); }
+    
     // Admin methods
     vector<User> getAllUsers();
+    RecordSpan<deque<User>> viewUsers() const { return RecordSpan<deque<User>>(users); } // No copies
     
     // Identity verification
     bool verifyIdentity(const string& username);
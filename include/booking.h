@@ -3,9 +3,26 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 #include <ctime>
+#include <unordered_map>
+#include <set>
+#include <array>
+#include <mutex>
+#include <type_traits>
+#include "date.h"
+#include "interval_tree.h"
+#include "string_pool.h"
+#include "motorbike_catalog.h"
+#include "text_index.h"
+#include "search_cache.h"
+#include "record_view.h"
+#include "cow_table.h"
+#include "epoch.h"
+#include "data_lock.h"
+#include "journal.h"
 
 using namespace std;
 
@@ -14,84 +31,121 @@ class Motorbike {
 private:
     string motorbikeId;
     string ownerUsername;
-    string brand;
-    string model;
-    string color;
-    string size;
+    uint32_t brandId;           // Interned in fieldPool()
+    uint32_t modelId;
+    uint32_t colorId;
+    uint32_t sizeId;
     string plateNo;
     double pricePerDay;
-    string location;
+    uint32_t locationId;
     bool isAvailable;
     double rating;
     string description;
-    string availableStartDate;  // Available rental period start date
-    string availableEndDate;    // Available rental period end date
+    Date availableStartDate;    // Available rental period start date
+    Date availableEndDate;      // Available rental period end date
     double minRenterRating;     // Minimum required renter rating
     bool isListed;              // Whether the motorbike is currently listed
     
 public:
-    // Constructor
-    Motorbike(const string& motorbikeId = "", const string& ownerUsername = "",
-              const string& brand = "", const string& model = "", 
-              const string& color = "", const string& size = "",
-              const string& plateNo = "", double pricePerDay = 0.0,
-              const string& location = "", bool isAvailable = true,
-              double rating = 0.0, const string& description = "",
-              const string& availableStartDate = "", const string& availableEndDate = "",
+    // Constructor: owned strings are taken by value and moved in; pooled
+    // fields are interned and dates parsed straight from the views
+    Motorbike(string motorbikeId = "", string ownerUsername = "",
+              string_view brand = "", string_view model = "", 
+              string_view color = "", string_view size = "",
+              string plateNo = "", double pricePerDay = 0.0,
+              string_view location = "", bool isAvailable = true,
+              double rating = 0.0, string description = "",
+              string_view availableStartDate = "", string_view availableEndDate = "",
               double minRenterRating = 0.0, bool isListed = false);
     
-    // Destructor
-    ~Motorbike() = default;
-    
     // Core functions
     void displayInfo() const;
     double calculateRentalCost(int days) const;
-    string getVehicleType() const { return "Motorbike"; }
+    string_view getVehicleType() const { return "Motorbike"; }
     
     // Getters
-    string getMotorbikeId() const { return motorbikeId; }
-    string getOwnerUsername() const { return ownerUsername; }
-    string getBrand() const { return brand; }
-    string getModel() const { return model; }
-    string getColor() const { return color; }
-    string getSize() const { return size; }
-    string getPlateNo() const { return plateNo; }
+    const string& getMotorbikeId() const { return motorbikeId; }
+    const string& getOwnerUsername() const { return ownerUsername; }
+    const string& getBrand() const { return fieldPool().str(brandId); }
+    const string& getModel() const { return fieldPool().str(modelId); }
+    const string& getColor() const { return fieldPool().str(colorId); }
+    const string& getSize() const { return fieldPool().str(sizeId); }
+    const string& getPlateNo() const { return plateNo; }
     double getPricePerDay() const { return pricePerDay; }
-    string getLocation() const { return location; }
+    const string& getLocation() const { return fieldPool().str(locationId); }
+    uint32_t getSizeId() const { return sizeId; }
+    uint32_t getLocationId() const { return locationId; }
     bool getIsAvailable() const { return isAvailable; }
     double getRating() const { return rating; }
-    string getDescription() const { return description; }
-    string getAvailableStartDate() const { return availableStartDate; }
-    string getAvailableEndDate() const { return availableEndDate; }
+    const string& getDescription() const { return description; }
+    string getAvailableStartDate() const { return availableStartDate.toString(); }
+    string getAvailableEndDate() const { return availableEndDate.toString(); }
+    Date getAvailableStart() const { return availableStartDate; }
+    Date getAvailableEnd() const { return availableEndDate; }
     double getMinRenterRating() const { return minRenterRating; }
     bool getIsListed() const { return isListed; }
     
     // Setters with validation
     void setMotorbikeId(const string& motorbikeId) { this->motorbikeId = motorbikeId; }
     void setOwnerUsername(const string& ownerUsername) { this->ownerUsername = ownerUsername; }
-    void setBrand(const string& brand) { this->brand = brand; }
-    void setModel(const string& model) { this->model = model; }
-    void setColor(const string& color) { this->color = color; }
-    void setSize(const string& size) { this->size = size; }
+    void setBrand(const string& brand) { brandId = fieldPool().intern(brand); }
+    void setModel(const string& model) { modelId = fieldPool().intern(model); }
+    void setColor(const string& color) { colorId = fieldPool().intern(color); }
+    void setSize(const string& size) { sizeId = fieldPool().intern(size); }
     void setPlateNo(const string& plateNo) { this->plateNo = plateNo; }
     void setPricePerDay(double pricePerDay) { this->pricePerDay = pricePerDay; }
-    void setLocation(const string& location) { this->location = location; }
+    void setLocation(const string& location) { locationId = fieldPool().intern(location); }
     void setIsAvailable(bool isAvailable) { this->isAvailable = isAvailable; }
     void setRating(double rating) { this->rating = rating; }
     void setDescription(const string& description) { this->description = description; }
-    void setAvailableStartDate(const string& date) { availableStartDate = date; }
-    void setAvailableEndDate(const string& date) { availableEndDate = date; }
+    void setAvailableStartDate(const string& date) { availableStartDate = Date::parse(date); }
+    void setAvailableEndDate(const string& date) { availableEndDate = Date::parse(date); }
+    void setAvailableStartDate(Date date) { availableStartDate = date; }
+    void setAvailableEndDate(Date date) { availableEndDate = date; }
     void setMinRenterRating(double rating);
     void setIsListed(bool isListed) { this->isListed = isListed; }
     
     // Business logic methods
     bool isAvailableForDate(const string& date) const;
     bool isAvailableForDateRange(const string& startDate, const string& endDate) const;
+    bool isAvailableForDate(Date date) const;
+    bool isAvailableForDateRange(Date startDate, Date endDate) const;
     bool meetsRenterRequirements(double renterRating) const;
     int getEngineSize() const;
     bool isElectric() const;
 };
 
+// Booking lifecycle: Pending -> Approved -> Completed, or Pending -> Rejected
+enum class BookingStatus : uint8_t {
+    Pending,
+    Approved,
+    Rejected,
+    Completed
+};
+
+const size_t BOOKING_STATUS_COUNT = 4;
+
+// BOOKING_TRANSITIONS[from][to] is true for every allowed status change
+constexpr bool BOOKING_TRANSITIONS[BOOKING_STATUS_COUNT][BOOKING_STATUS_COUNT] = {
+    //            Pending  Approved  Rejected  Completed
+    /* Pending   */ {false, true,     true,     false},
+    /* Approved  */ {false, false,    false,    true},
+    /* Rejected  */ {false, false,    false,    false},
+    /* Completed */ {false, false,    false,    false},
+};
+
+constexpr bool canTransition(BookingStatus from, BookingStatus to) {
+    return BOOKING_TRANSITIONS[static_cast<size_t>(from)][static_cast<size_t>(to)];
+}
+
+static_assert(canTransition(BookingStatus::Pending, BookingStatus::Approved) &&
+              !canTransition(BookingStatus::Rejected, BookingStatus::Approved),
+              "Booking transition table mismatch");
+
+// Text form used in bookings.txt, the journal and the UI
+const string& bookingStatusName(BookingStatus status);
+bool parseBookingStatus(string_view text, BookingStatus& status);
+
 // Booking class with proper encapsulation
 class Booking {
 private:
@@ -99,64 +153,69 @@ private:
     string renterUsername;
     string ownerUsername;
     string motorbikeId;
-    string startDate;
-    string endDate;
-    string status; // "Pending", "Approved", "Rejected", "Completed"
+    Date startDate;
+    Date endDate;
+    BookingStatus status;
     double totalCost;
-    string brand;
-    string model;
-    string color;
-    string size;
+    uint32_t brandId;
+    uint32_t modelId;
+    uint32_t colorId;
+    uint32_t sizeId;
     string plateNo;
     
 public:
-    // Constructor
-    Booking(const string& bookingId = "", const string& renterUsername = "",
-            const string& ownerUsername = "", const string& motorbikeId = "",
-            const string& startDate = "", const string& endDate = "",
-            const string& status = "Pending", double totalCost = 0.0,
-            const string& brand = "", const string& model = "",
-            const string& color = "", const string& size = "",
-            const string& plateNo = "");
-    
-    // Destructor
-    ~Booking() = default;
+    // Constructor: owned strings are taken by value and moved in; pooled
+    // fields, dates and status are read straight from the views
+    Booking(string bookingId = "", string renterUsername = "",
+            string ownerUsername = "", string motorbikeId = "",
+            string_view startDate = "", string_view endDate = "",
+            string_view status = "Pending", double totalCost = 0.0,
+            string_view brand = "", string_view model = "",
+            string_view color = "", string_view size = "",
+            string plateNo = "");
     
     // Getters
-    string getBookingId() const { return bookingId; }
-    string getRenterUsername() const { return renterUsername; }
-    string getOwnerUsername() const { return ownerUsername; }
-    string getMotorbikeId() const { return motorbikeId; }
-    string getStartDate() const { return startDate; }
-    string getEndDate() const { return endDate; }
-    string getStatus() const { return status; }
+    const string& getBookingId() const { return bookingId; }
+    const string& getRenterUsername() const { return renterUsername; }
+    const string& getOwnerUsername() const { return ownerUsername; }
+    const string& getMotorbikeId() const { return motorbikeId; }
+    string getStartDate() const { return startDate.toString(); }
+    string getEndDate() const { return endDate.toString(); }
+    Date getStart() const { return startDate; }
+    Date getEnd() const { return endDate; }
+    const string& getStatus() const { return bookingStatusName(status); }
+    BookingStatus getStatusCode() const { return status; }
     double getTotalCost() const { return totalCost; }
-    string getBrand() const { return brand; }
-    string getModel() const { return model; }
-    string getColor() const { return color; }
-    string getSize() const { return size; }
-    string getPlateNo() const { return plateNo; }
+    const string& getBrand() const { return fieldPool().str(brandId); }
+    const string& getModel() const { return fieldPool().str(modelId); }
+    const string& getColor() const { return fieldPool().str(colorId); }
+    const string& getSize() const { return fieldPool().str(sizeId); }
+    const string& getPlateNo() const { return plateNo; }
     
     // Setters with validation
     void setBookingId(const string& bookingId) { this->bookingId = bookingId; }
     void setRenterUsername(const string& renterUsername) { this->renterUsername = renterUsername; }
     void setOwnerUsername(const string& ownerUsername) { this->ownerUsername = ownerUsername; }
     void setMotorbikeId(const string& motorbikeId) { this->motorbikeId = motorbikeId; }
-    void setStartDate(const string& startDate) { this->startDate = startDate; }
-    void setEndDate(const string& endDate) { this->endDate = endDate; }
-    void setStatus(const string& status);
+    void setStartDate(const string& startDate) { this->startDate = Date::parse(startDate); }
+    void setEndDate(const string& endDate) { this->endDate = Date::parse(endDate); }
+    void setStartDate(Date startDate) { this->startDate = startDate; }
+    void setEndDate(Date endDate) { this->endDate = endDate; }
+    void setStatus(string_view status);     // Any valid status, used when loading records
+    void setStatus(BookingStatus status) { this->status = status; }
+    bool transitionTo(BookingStatus next);  // Only the changes in BOOKING_TRANSITIONS
     void setTotalCost(double totalCost);
-    void setBrand(const string& brand) { this->brand = brand; }
-    void setModel(const string& model) { this->model = model; }
-    void setColor(const string& color) { this->color = color; }
-    void setSize(const string& size) { this->size = size; }
+    void setBrand(const string& brand) { brandId = fieldPool().intern(brand); }
+    void setModel(const string& model) { modelId = fieldPool().intern(model); }
+    void setColor(const string& color) { colorId = fieldPool().intern(color); }
+    void setSize(const string& size) { sizeId = fieldPool().intern(size); }
     void setPlateNo(const string& plateNo) { this->plateNo = plateNo; }
     
     // Business logic methods
-    bool isPending() const { return status == "Pending"; }
-    bool isApproved() const { return status == "Approved"; }
-    bool isRejected() const { return status == "Rejected"; }
-    bool isCompleted() const { return status == "Completed"; }
+    bool isPending() const { return status == BookingStatus::Pending; }
+    bool isApproved() const { return status == BookingStatus::Approved; }
+    bool isRejected() const { return status == BookingStatus::Rejected; }
+    bool isCompleted() const { return status == BookingStatus::Completed; }
     int getDurationInDays() const;
     void displayInfo() const;
 };
@@ -173,32 +232,226 @@ private:
 
 public:
     // Constructor
-    Review(const string& reviewId = "", const string& motorbikeId = "",
-           const string& renterUsername = "", double rating = 0.0,
-           const string& comment = "", const string& reviewDate = "");
+    Review(string reviewId = "", string motorbikeId = "",
+           string renterUsername = "", double rating = 0.0,
+           string comment = "", string reviewDate = "");
     
     // Getters
-    string getReviewId() const { return reviewId; }
-    string getMotorbikeId() const { return motorbikeId; }
-    string getRenterUsername() const { return renterUsername; }
+    const string& getReviewId() const { return reviewId; }
+    const string& getMotorbikeId() const { return motorbikeId; }
+    const string& getRenterUsername() const { return renterUsername; }
     double getRating() const { return rating; }
-    string getComment() const { return comment; }
-    string getReviewDate() const { return reviewDate; }
+    const string& getComment() const { return comment; }
+    const string& getReviewDate() const { return reviewDate; }
+};
+
+// Records are moved, not copied, when tables grow or loaders hand them over;
+// a user-declared destructor would silently turn those moves into copies
+static_assert(is_nothrow_move_constructible<Motorbike>::value &&
+              is_nothrow_move_constructible<Booking>::value &&
+              is_nothrow_move_constructible<Review>::value, "Records must stay nothrow-movable");
+
+// Why a booking request was refused; None means the booking was created
+enum class BookingError : uint8_t {
+    None,
+    MotorbikeNotFound,
+    InvalidDates,
+    RatingTooLow,
+    InsufficientCredits,
+    ActiveRental,
+    LicenseRequired,
+    OutsideAvailability,
+    AlreadyBooked,          // Overlaps an approved booking
+    BatchConflict,          // Overlaps an earlier request for the same motorbike in the batch
+    NotSaved                // Created, but its journal write failed; the next write retries it
+};
+
+const string& bookingErrorMessage(BookingError error);
+
+// One rental request of a createBookings batch
+struct BookingRequest {
+    string renter;
+    string motorbikeId;
+    string startDate;       // DD/MM/YYYY
+    string endDate;
+};
+
+// Outcome of the BookingRequest at the same index of the batch
+struct BookingResult {
+    BookingError error = BookingError::None;
+    string bookingId;       // Set when the booking was created
+    double totalCost = 0.0;
+    
+    bool created() const { return error == BookingError::None; }
 };
 
+// Result order of a paged search: cheapest daily price, best rating, or
+// cheapest total cost for the searched period. Ties go to the older listing.
+enum class SearchSortKey {
+    Price,
+    Rating,
+    TotalCost
+};
+
+// Position after the last result of a page; pass it back to get the next one
+struct SearchCursor {
+    double key = 0.0;       // Sort key of the last result (negated for Rating)
+    size_t slot = 0;        // Motorbike slot of the last result
+    bool valid = false;     // False = start from the first result
+};
+
+struct SearchRequest {
+    string startDate;       // DD/MM/YYYY
+    string endDate;         // Empty for a single-date search
+    string city;
+    SearchSortKey sortKey = SearchSortKey::Price;
+    size_t limit = 20;
+    SearchCursor after;
+};
+
+struct SearchPage {
+    vector<Motorbike> results;  // At most limit motorbikes, in sort order
+    size_t totalMatches = 0;    // Matches across all pages
+    bool hasMore = false;       // More results after this page
+    SearchCursor next;          // Resume point for the following page
+};
+
+class BookingSnapshot;
+
 class BookingManager {
 private:
-    vector<Booking> bookings;
-    vector<Motorbike> motorbikes;
+    // Pending and approved booking periods of one motorbike, valued by booking slot
+    struct MotorbikeSchedule {
+        IntervalTree<Date, size_t> approved;
+        IntervalTree<Date, size_t> pending;
+    };
+    
+    DataLock dataLock;      // First: nothing is loaded or saved without it
+    
+    // Paged so snapshots can share them; a changed record's page is cloned first
+    CowTable<Booking> bookings;
+    CowTable<Motorbike> motorbikes;
     vector<Review> reviews;
+    unordered_map<string, size_t> bookingIndex;   // bookingId -> slot in bookings
+    unordered_map<string, size_t> motorbikeIndex; // motorbikeId -> slot in motorbikes
+    unordered_map<string, MotorbikeSchedule> schedules; // motorbikeId -> booking intervals
+    MotorbikeCatalog catalog;                     // Columnar search fields, row = motorbike slot
+    TextIndex textIndex;                          // Keywords -> motorbike slots (listing text and reviews)
+    SearchCache searchCache;                      // (city, dates) -> renter-independent candidate slots
+    vector<uint32_t> locations;                   // Distinct motorbike location ids, for snapshot searches
+    
+    // Running review aggregates of one motorbike, maintained by putReview
+    struct ReviewStats {
+        double ratingSum = 0.0;
+        int count = 0;
+        int histogram[5] = {};      // Reviews per star, ratings rounded to the nearest star
+        vector<size_t> slots;       // Its reviews, as slots in reviews
+    };
+    unordered_map<string, ReviewStats> reviewStats; // motorbikeId -> aggregates
+    
+    // Secondary booking indexes, maintained by putBooking/indexBooking/unindexBooking
+    // and the transition hooks
+    CowIndex<vector<size_t>> renterBookings;              // renter -> all their bookings
+    CowIndex<set<size_t>> ownerRequests;                  // owner -> pending requests
+    unordered_map<string, int> renterActiveRentals;       // renter -> approved bookings
+    unordered_map<string, int> ownerActiveRentals;        // owner -> approved bookings
     string bookingFilename;
     string motorbikeFilename;
     string reviewFilename;
     
+    // Booking journal: one appended record per change, replayed on top of
+    // bookings.txt and motorbikes.txt at startup and folded back into them
+    // during compaction. C|<booking record> adds a booking, S|bookingId|status
+    // changes its status, A|motorbikeId|0 or 1 sets a motorbike's
+    // availability and L|<motorbike record> adds or changes a listing.
+    // K records are credit changes (see Auth), an approval's or those of a
+    // group commit: replay leaves them to Auth, and compaction carries each user's latest
+    // one over until account.txt contains it. B|count groups the records of
+    // one change (see Journal).
+    Journal journal;
+    unordered_map<string, pair<uint64_t, string>> journalCredits; // username -> (change, K record)
+    uint64_t creditWatermark;   // Auth::getSavedCreditChanges as last seen
+    mutex compactMutex;         // One compaction at a time
+    static const int JOURNAL_COMPACT_THRESHOLD = 500;
+    
+    // Read-only state for other threads, replaced after every public change
+    Published<BookingSnapshot> published;
+    uint64_t publishedVersion;
+    void publishSnapshot();
+    
+    // Locks of the booking calls that may run concurrently (see the public
+    // section). Every change to a motorbike's bookings holds its stripe of
+    // motorbikeLocks from the first check to the last write, which is what
+    // prevents double booking; stateMutex guards everything above, and is
+    // held only while it is read or changed. Order: motorbike stripes in
+    // ascending index, then stateMutex, then an Auth credit lock. A change
+    // appends its journal records before releasing stateMutex, which orders
+    // them, and waits for them to be written after releasing it; file writes
+    // never run under stateMutex.
+    static const size_t MOTORBIKE_LOCK_STRIPES = 64;
+    array<mutex, MOTORBIKE_LOCK_STRIPES> motorbikeLocks;
+    mutex stateMutex;
+    mutex motorbikeFileMutex;       // motorbikes.txt rewrites, one at a time
+    uint64_t savedMotorbikeVersion; // Snapshot version last written to motorbikes.txt
+    size_t motorbikeStripe(const string& motorbikeId) const;
+    unique_lock<mutex> writerLock(mutex& m);
+    bool findBookingMotorbike(const string& bookingId, string& motorbikeId);
+    
+    // Work held back while a group commit is open (beginGroupCommit)
+    bool groupCommitOpen;
+    string groupJournal;
+    int groupJournalRecords;
+    bool groupPublishPending;
+    
     void loadBookings();
-    void saveBookings();
+    bool saveBookings(const BookingSnapshot& snapshot);
+    int replayJournal();
+    uint64_t queueJournal(const string& records, int count);
+    bool commitJournal(uint64_t sequence);
+    bool compactJournal();
+    void compactJournalIfDue();
+    void noteCreditRecord(const string& record);
+    string statusRecord(const Booking& booking) const;
+    string availabilityRecord(const Motorbike& motorbike) const;
+    string formatBookingRecord(const Booking& booking) const;
+    string formatMotorbikeRecord(const Motorbike& motorbike) const;
+    bool journalListing(const Motorbike& motorbike);
+    bool parseBookingRecord(string_view line, Booking& booking) const;
+    void putBooking(Booking booking);
+    Booking* findBooking(const string& bookingId);      // Writable; clones the booking's page if shared
+    Motorbike* findMotorbike(const string& motorbikeId); // Writable; clones the motorbike's page if shared
+    
+    // Status changes: transitionBooking validates against BOOKING_TRANSITIONS and
+    // runs the hook for that transition, which moves the booking between indexes
+    typedef void (BookingManager::*TransitionHook)(size_t slot);
+    bool transitionBooking(Booking& booking, BookingStatus next);
+    void onApproved(size_t slot);   // Pending -> Approved
+    void onRejected(size_t slot);   // Pending -> Rejected
+    void onCompleted(size_t slot);  // Approved -> Completed
+    
+    // Date-based internals behind the public DD/MM/YYYY string API
+    bool hasOverlappingApprovedBookings(const string& motorbikeId, Date startDate, Date endDate);
+    int rejectOverlappingRequests(const string& motorbikeId, Date startDate, Date endDate,
+                                  const string& approvedBookingId, string& records);
+    bool meetsSearchCriteria(const Motorbike& motorbike, Date searchDate, uint32_t cityId,
+                             double renterRating, double renterCredits);
+    bool meetsDateRangeSearchCriteria(const Motorbike& motorbike, Date startDate, Date endDate,
+                                      uint32_t cityId, double renterRating, double renterCredits);
+    double calculateTotalCost(const Motorbike& motorbike, Date startDate, Date endDate);
+    void indexBooking(size_t slot);
+    void unindexBooking(size_t slot);
+    bool putMotorbike(Motorbike motorbike);
+    BookingError checkBookingRequest(const string& renter, const Motorbike* motorbike, Date start, Date end,
+                                     class Auth& auth, double& totalCost);
+    Booking makeBooking(const string& renter, const Motorbike& motorbike, Date start, Date end, double totalCost);
+    void syncCatalog(const Motorbike& motorbike);
+    void markOccupied(const Booking& booking);
+    void refreshOccupancy(const string& motorbikeId);
+    void invalidateSearches(size_t slot);
+    size_t selectMotorbikes(const CatalogQuery& query, vector<uint64_t>& selection);
     void loadMotorbikes();
-    void saveMotorbikes();
+    bool writeMotorbikes(const BookingSnapshot& snapshot);
+    void putReview(Review review);
     void loadReviews();
     void saveReviews();
     string generateBookingId();
@@ -211,22 +464,77 @@ public:
     // Destructor
     ~BookingManager();
     
+    // False when another process holds data/.lock: nothing was loaded and
+    // nothing is saved; the caller should exit
+    bool hasDataLock() const { return dataLock.isHeld(); }
+    
     // Booking management
     bool createBooking(const string& renter, const string& motorbikeId, 
                       const string& startDate, const string& endDate, class Auth& auth);
+    vector<BookingResult> createBookings(const vector<BookingRequest>& batch, class Auth& auth);
     bool approveBooking(const string& bookingId, const string& owner, class Auth& auth);
     bool rejectBooking(const string& bookingId, const string& owner);
     vector<Booking> getUserBookings(const string& username);
     vector<Booking> getUserRentalRequests(const string& username);
     vector<Booking> getAllBookings(); // Get all bookings for admin view
     
+    // Read-only access without copying; valid until the next booking change
+    RecordSpan<CowTable<Booking>> viewBookings() const { return RecordSpan<CowTable<Booking>>(bookings); }
+    
+    // Calls fn(const Booking&) for each booking of a renter, in creation order
+    template <typename Fn>
+    void forEachUserBooking(const string& username, Fn fn) const {
+        if (const vector<size_t>* slots = renterBookings.find(username)) {
+            for (size_t slot : *slots) {
+                fn(bookings[slot]);
+            }
+        }
+    }
+    
+    // Calls fn(const Booking&) for each pending request on an owner's motorbikes
+    template <typename Fn>
+    void forEachRentalRequest(const string& ownerUsername, Fn fn) const {
+        if (const set<size_t>* slots = ownerRequests.find(ownerUsername)) {
+            for (size_t slot : *slots) {
+                fn(bookings[slot]);
+            }
+        }
+    }
+    
+    // createBooking, createBookings, approveBooking, rejectBooking and
+    // completeRental may be called from several threads at once; calls on
+    // different motorbikes mostly proceed in parallel. Everything else reads
+    // or changes the live state without locking and must stay on one thread,
+    // never overlapping those calls. snapshot() may be called from any thread
+    // at any time: it returns the state as of the last completed change,
+    // without locking, and keeps it alive while the pin is in scope. Include
+    // booking_snapshot.h to use it.
+    Published<BookingSnapshot>::Pin snapshot() const { return published.read(); }
+    
+    // Group commit and single-writer mode, for a caller that makes every
+    // change to this manager and auth from one thread (CommandQueue). Until
+    // endGroupCommit, changes apply to the live state as usual, but the
+    // calls above take none of their locks, journal records and auth's
+    // credit changes are buffered, and no snapshot is published.
+    // endGroupCommit writes all of the records, listings included, as one
+    // journal append with one disk sync and publishes one snapshot; it
+    // returns false when that write failed.
+    void beginGroupCommit(class Auth& auth);
+    bool endGroupCommit(class Auth& auth);
+    
     // Motorbike management
     bool addMotorbike(const Motorbike& motorbike);
     vector<Motorbike> getAvailableMotorbikes();
     vector<Motorbike> getAllMotorbikes(); // Get all motorbikes for admin view
     vector<Motorbike> getGuestMotorbikes(); // Get motorbikes for guest view (limited info)
     vector<Motorbike> getUserMotorbikes(const string& username);
-    Motorbike* getMotorbikeById(const string& motorbikeId);
+    const Motorbike* getMotorbikeById(const string& motorbikeId) const;
+    
+    // Read-only access without copying; valid until the next motorbike change
+    typedef FilteredRange<CowTable<Motorbike>, bool (*)(const Motorbike&)> MotorbikeRange;
+    RecordSpan<CowTable<Motorbike>> viewMotorbikes() const { return RecordSpan<CowTable<Motorbike>>(motorbikes); }
+    MotorbikeRange viewAvailableMotorbikes() const; // Listed and available
+    MotorbikeRange viewGuestMotorbikes() const;     // Listed
     
     // Electric motorbike listing management
     bool listMotorbike(const string& ownerUsername, const string& brand, 
@@ -250,6 +558,7 @@ public:
     // Motorbike search and filtering methods
     vector<Motorbike> searchMotorbikes(const string& searchDate, const string& city, 
                                            const string& username, class Auth& auth);
+    SearchPage searchMotorbikesPage(const SearchRequest& request, const string& username, class Auth& auth);
     vector<Motorbike> searchMotorbikesByDateRange(const string& startDate, const string& endDate, 
                                                       const string& city, const string& username, class Auth& auth);
     bool meetsSearchCriteria(const Motorbike& motorbike, const string& searchDate, 
@@ -260,8 +569,12 @@ public:
     double calculateTotalCost(const Motorbike& motorbike, const string& startDate, const string& endDate);
     int getEngineSize(const string& size);
     bool hasValidLicense(const string& username, class Auth& auth, int engineSize);
+    vector<Motorbike> searchMotorbikesByKeyword(const string& keywords, size_t limit = 20);
+    SearchCache::Stats getSearchCacheStats() const { return searchCache.getStats(); }
     vector<string> getMotorbikeReviews(const string& motorbikeId);
     double getAverageRating(const string& motorbikeId);
+    int getReviewCount(const string& motorbikeId);
+    vector<int> getRatingDistribution(const string& motorbikeId); // Count per star, index 0 = 1 star
     
     // Rental request validation and management
     bool hasActiveRental(const string& username);
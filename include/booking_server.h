@@ -0,0 +1,41 @@
+#ifndef BOOKING_SERVER_H
+#define BOOKING_SERVER_H
+
+#include "socket_server.h"
+#include "protocol.h"
+#include "booking.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+class Auth;
+
+// Serves one Auth and BookingManager to many clients using the binary
+// protocol in protocol.h, normally over a Unix domain socket (Linux only).
+// All requests run on the event loop thread, one at a time, so the engine
+// needs no locking and the data files have a single writer.
+class BookingServer : public SocketServer {
+private:
+    Auth& auth;
+    BookingManager& bookingManager;
+    vector<const Booking*> bookingScratch;
+
+    size_t handleInput(Connection& connection) override;
+    void handleRequest(Connection& connection, string_view payload);
+    void handleLogin(Connection& connection, FrameReader& request);
+    void handleSearch(Connection& connection, FrameReader& request);
+    void handleBook(Connection& connection, FrameReader& request);
+    void handleBookingList(Connection& connection, FrameReader& request, bool rentalRequests);
+    void handleDecision(Connection& connection, FrameReader& request, bool approve);
+    void handleProfile(Connection& connection, FrameReader& request);
+    bool endOfRequest(Connection& connection, FrameReader& request);
+    void replyStatus(Connection& connection, ResponseStatus status);
+    void replyError(Connection& connection, BookingError error, const string& fallback);
+
+public:
+    BookingServer(EventLoop& loop, Auth& auth, BookingManager& bookingManager);
+};
+
+#endif
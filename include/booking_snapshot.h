@@ -0,0 +1,99 @@
+#ifndef BOOKING_SNAPSHOT_H
+#define BOOKING_SNAPSHOT_H
+
+#include "booking.h"
+#include "cow_table.h"
+#include "motorbike_catalog.h"
+#include "record_view.h"
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Immutable BookingManager state as of one completed change: the motorbike
+// and booking tables, the search catalog and the per-user booking indexes.
+// BookingManager::snapshot() hands the latest one to any thread without
+// locking, and it stays valid and unchanged for as long as the caller holds
+// the returned pin, however many changes are published meanwhile. It shares
+// its pages with the manager's tables, which clone a page before changing
+// it (cow_table.h), so taking a snapshot costs O(pages), not O(records).
+//
+// Searches take the renter's rating and credit balance from the caller,
+// since accounts (Auth) are not part of the snapshot, and scan the catalog
+// directly instead of going through the manager's search cache.
+class BookingSnapshot {
+private:
+    CowTable<Motorbike> motorbikes;
+    CowTable<Booking> bookings;
+    MotorbikeCatalog catalog;
+    CowIndex<vector<size_t>> renterBookings;    // renter -> all their bookings
+    CowIndex<set<size_t>> ownerRequests;        // owner -> pending requests
+    vector<uint32_t> locations;                 // Location ids in the catalog
+    uint64_t version;
+
+    // Matches city against the catalog's locations; the pool's own index
+    // belongs to the writer thread (string_pool.h)
+    uint32_t findCity(const string& city) const;
+    vector<Motorbike> collect(const CatalogQuery& query) const;
+
+public:
+    BookingSnapshot(const CowTable<Motorbike>& motorbikes, const CowTable<Booking>& bookings,
+                    const MotorbikeCatalog& catalog, const CowIndex<vector<size_t>>& renterBookings,
+                    const CowIndex<set<size_t>>& ownerRequests, const vector<uint32_t>& locations,
+                    uint64_t version);
+
+    // Changes published before this snapshot; increases with every publish
+    uint64_t getVersion() const { return version; }
+
+    // Same results as the BookingManager searches of the same name
+    vector<Motorbike> searchMotorbikes(const string& searchDate, const string& city,
+                                       double renterRating, double renterCredits) const;
+    vector<Motorbike> searchMotorbikesByDateRange(const string& startDate, const string& endDate,
+                                                  const string& city, double renterRating,
+                                                  double renterCredits) const;
+    SearchPage searchMotorbikesPage(const SearchRequest& request, double renterRating,
+                                    double renterCredits) const;
+
+    vector<Booking> getUserBookings(const string& username) const;
+    vector<Booking> getUserRentalRequests(const string& username) const;
+
+    RecordSpan<CowTable<Motorbike>> viewMotorbikes() const { return RecordSpan<CowTable<Motorbike>>(motorbikes); }
+    RecordSpan<CowTable<Booking>> viewBookings() const { return RecordSpan<CowTable<Booking>>(bookings); }
+
+    // Calls fn(const Booking&) for each booking of a renter, in creation order
+    template <typename Fn>
+    void forEachUserBooking(const string& username, Fn fn) const {
+        if (const vector<size_t>* slots = renterBookings.find(username)) {
+            for (size_t slot : *slots) {
+                fn(bookings[slot]);
+            }
+        }
+    }
+
+    // Calls fn(const Booking&) for each pending request on an owner's motorbikes
+    template <typename Fn>
+    void forEachRentalRequest(const string& ownerUsername, Fn fn) const {
+        if (const set<size_t>* slots = ownerRequests.find(ownerUsername)) {
+            for (size_t slot : *slots) {
+                fn(bookings[slot]);
+            }
+        }
+    }
+};
+
+// Search steps shared by BookingManager and BookingSnapshot
+
+// Catalog query for renting in cityId from start to end (equal for a
+// single-day search); false if no motorbike can match
+bool makeSearchQuery(uint32_t cityId, Date start, Date end, bool requireFree,
+                     double renterRating, double renterCredits, CatalogQuery& query);
+
+// Fills page.results, hasMore and next from the selected motorbikes. Only the
+// requested page is ranked and copied: a bounded max-heap keeps the best
+// limit entries after the cursor, so a page costs O(n log limit).
+void rankSearchPage(const SearchRequest& request, const CatalogQuery& query,
+                    const CowTable<Motorbike>& motorbikes, const vector<uint64_t>& selection,
+                    SearchPage& page);
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include "booking.h"
+#include "mpsc_ring.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+class Auth;
+
+// Changes CommandQueue can apply, one per mutating engine call
+enum class CommandType : uint8_t {
+    CreateBooking,      // BookingManager::createBookings with one request
+    ApproveBooking,
+    RejectBooking,
+    CompleteRental,
+    ListMotorbike,
+    TopUpCredits,       // Auth::topUpCreditPoints
+    DeductCredits       // Auth::deductCreditPoints
+};
+
+// Fields of a ListMotorbike command
+struct MotorbikeListing {
+    string brand;
+    string model;
+    string color;
+    string size;
+    string plateNo;
+    double pricePerDay = 0.0;
+    string location;
+    string availableStartDate;  // DD/MM/YYYY
+    string availableEndDate;
+    double minRenterRating = 0.0;
+};
+
+// One change, as data. Build it with the function named after its type.
+struct BookingCommand {
+    CommandType type = CommandType::CreateBooking;
+    string username;        // Renter (CreateBooking, CompleteRental), owner (ApproveBooking,
+                            // RejectBooking, ListMotorbike) or account holder (credits)
+    string target;          // motorbikeId (CreateBooking) or bookingId
+    string startDate;       // CreateBooking, DD/MM/YYYY
+    string endDate;
+    double amount = 0.0;    // TopUpCredits, DeductCredits
+    shared_ptr<const MotorbikeListing> listing;     // ListMotorbike; out of line to keep commands small
+
+    static BookingCommand createBooking(const string& renter, const string& motorbikeId,
+                                        const string& startDate, const string& endDate);
+    static BookingCommand approveBooking(const string& bookingId, const string& owner);
+    static BookingCommand rejectBooking(const string& bookingId, const string& owner);
+    static BookingCommand completeRental(const string& bookingId, const string& renter);
+    static BookingCommand listMotorbike(const string& owner, const MotorbikeListing& listing);
+    static BookingCommand topUpCredits(const string& username, double amount);
+    static BookingCommand deductCredits(const string& username, double amount);
+};
+
+struct CommandResult {
+    bool ok = false;                        // What the engine call returned
+    BookingError error = BookingError::None; // Why a CreateBooking was refused
+    string bookingId;                       // Set by a successful CreateBooking
+    double totalCost = 0.0;
+    string messages;                        // What the call wrote to messageStream()
+    uint64_t sequence = 0;                  // Position in the apply order, from 1
+};
+
+// Single-writer front end for Auth and BookingManager. Any number of
+// threads submit commands onto a lock-free ring (mpsc_ring.h); one apply
+// thread drains it in batches and applies each command in submission
+// order, so the outcome depends only on that order. The apply thread runs
+// the calls in single-writer mode, taking none of their motorbike, state or
+// credit locks, and group-commits each batch: its booking, status,
+// availability, listing and credit records are one journal append with one
+// flush, kept whole or not at all after a crash, and one snapshot is published
+// (BookingManager::beginGroupCommit). A command's future is fulfilled only
+// after its batch is committed; if that write fails, every command of the
+// batch that succeeded reports ok = false instead.
+//
+// While a queue is running, every change must go through it and Auth must
+// not be used from other threads; reads can use BookingManager::snapshot()
+// from any thread. The socket and HTTP servers do not use it: they apply
+// one request at a time on their event loop thread. Its user is
+// bench/approval_benchmark.cpp.
+class CommandQueue {
+private:
+    struct PendingCommand {
+        BookingCommand command;
+        promise<CommandResult> result;
+    };
+
+    static const size_t MAX_BATCH = 256;
+
+    BookingManager& bookingManager;
+    Auth& auth;
+    MpscRing<PendingCommand> ring;
+    uint64_t applied;                   // Apply thread only
+
+    // Parking for the apply thread when the ring is empty. Producers only
+    // take wakeMutex when they find sleeping set, so submitting takes no lock.
+    atomic<bool> sleeping;
+    atomic<bool> stopping;
+    mutex wakeMutex;
+    condition_variable wake;
+
+    atomic<uint64_t> commandCount;
+    atomic<uint64_t> batchCount;
+
+    thread applier;                     // Last, so it starts after everything above
+
+    void run();
+    CommandResult apply(const BookingCommand& command);
+
+public:
+    // capacity = commands the ring holds before submit has to wait
+    CommandQueue(BookingManager& bookingManager, Auth& auth, size_t capacity = 4096);
+
+    // Applies everything already submitted, then stops the apply thread
+    ~CommandQueue();
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    // Safe from any thread; waits only while the ring is full
+    future<CommandResult> submit(BookingCommand command);
+
+    struct Stats {
+        uint64_t commands;
+        uint64_t batches;       // commands / batches = average group commit size
+    };
+    Stats getStats() const { return {commandCount.load(), batchCount.load()}; }
+};
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef COW_TABLE_H
+#define COW_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Record table kept in fixed-size pages that copies of the table share.
+// Copying a table copies only its page directory, which makes the copy an
+// immutable point-in-time view (see BookingSnapshot); changing a record
+// through the original first clones its page if a copy still shares it.
+// Pages are allocated at full capacity, so records never move while their
+// page is unshared: references stay valid until the table is next copied.
+template <typename T>
+class CowTable {
+private:
+    static const size_t PAGE_BITS = 7;
+    static const size_t PAGE_SIZE = size_t(1) << PAGE_BITS;
+
+    typedef vector<T> Page;
+
+    vector<shared_ptr<Page>> pages;
+    size_t count = 0;
+
+    static shared_ptr<Page> newPage() {
+        shared_ptr<Page> page = make_shared<Page>();
+        page->reserve(PAGE_SIZE);
+        return page;
+    }
+
+    Page& writablePage(size_t page) {
+        shared_ptr<Page>& current = pages[page];
+        if (current.use_count() > 1) {
+            shared_ptr<Page> copy = newPage();
+            copy->insert(copy->end(), current->begin(), current->end());
+            current = move(copy);
+        }
+        return *current;
+    }
+
+public:
+    typedef T value_type;
+
+    class const_iterator {
+    private:
+        const CowTable* table;
+        size_t index;
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator(const CowTable* table = nullptr, size_t index = 0) : table(table), index(index) {}
+
+        reference operator*() const { return (*table)[index]; }
+        pointer operator->() const { return &(*table)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++index; return old; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+    };
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t index) const { return (*pages[index >> PAGE_BITS])[index & (PAGE_SIZE - 1)]; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+    // Writable record at index, cloning its page if a copy shares it
+    T& mutate(size_t index) { return writablePage(index >> PAGE_BITS)[index & (PAGE_SIZE - 1)]; }
+
+    const T& push_back(T record) {
+        if ((count & (PAGE_SIZE - 1)) == 0) {
+            pages.push_back(newPage());
+        }
+        Page& page = writablePage(pages.size() - 1);
+        page.push_back(move(record));
+        count++;
+        return page.back();
+    }
+
+    void reserve(size_t records) { pages.reserve((records + PAGE_SIZE - 1) >> PAGE_BITS); }
+    void clear() { pages.clear(); count = 0; }
+};
+
+// String-keyed index split into shards that copies share the way CowTable
+// shares pages: a copy costs O(SHARDS) and a change clones only the shard
+// holding its key.
+template <typename V>
+class CowIndex {
+private:
+    static const size_t SHARDS = 256;
+
+    typedef unordered_map<string, V> Shard;
+
+    array<shared_ptr<Shard>, SHARDS> shards;   // Null until a key lands in it
+
+    static size_t shardOf(const string& key) { return hash<string>()(key) % SHARDS; }
+
+public:
+    // Value for key, or nullptr if it was never set
+    const V* find(const string& key) const {
+        const shared_ptr<Shard>& shard = shards[shardOf(key)];
+        if (!shard) {
+            return nullptr;
+        }
+        auto it = shard->find(key);
+        return it != shard->end() ? &it->second : nullptr;
+    }
+
+    // Writable value for key, default-constructed if absent; clones the
+    // key's shard if a copy shares it
+    V& operator[](const string& key) {
+        shared_ptr<Shard>& shard = shards[shardOf(key)];
+        if (!shard) {
+            shard = make_shared<Shard>();
+        } else if (shard.use_count() > 1) {
+            shard = make_shared<Shard>(*shard);
+        }
+        return (*shard)[key];
+    }
+
+    void clear() { shards.fill(nullptr); }
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef DATA_LOCK_H
+#define DATA_LOCK_H
+
+#include <string>
+
+using namespace std;
+
+// Exclusive lock on the data directory (an flock on data/.lock), so a
+// second process - another console application or a server - cannot load
+// the data files and later overwrite what this one wrote. Auth and
+// BookingManager each hold one; within a process they share the lock, so
+// both can be created (or re-created) side by side. The lock is dropped
+// when the last holder goes away. POSIX only; elsewhere it always succeeds.
+class DataLock {
+private:
+    bool held;
+
+public:
+    explicit DataLock(const string& filename = "data/.lock");
+    ~DataLock();
+
+    DataLock(const DataLock&) = delete;
+    DataLock& operator=(const DataLock&) = delete;
+
+    // False when another process holds the lock; a message has been written
+    // to messageStream()
+    bool isHeld() const { return held; }
+};
+
+#endif
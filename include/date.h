@@ -0,0 +1,135 @@
+#ifndef DATE_H
+#define DATE_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+using namespace std;
+
+// Calendar date packed into a single day number (days since 01/01/1970).
+// Dates are parsed from DD/MM/YYYY once, after which ordering, overlap and
+// rental-length math are plain integer operations.
+class Date {
+private:
+    int32_t days;
+
+    static constexpr int32_t INVALID_DAY = INT32_MIN;
+
+    static constexpr bool isLeapYear(int year) {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    static constexpr int daysInMonth(int year, int month) {
+        constexpr int lengths[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return month == 2 && isLeapYear(year) ? 29 : lengths[month - 1];
+    }
+
+    static constexpr int digit(char c) {
+        return c >= '0' && c <= '9' ? c - '0' : -1;
+    }
+
+    // Days-from-civil conversion for the proleptic Gregorian calendar
+    static constexpr int32_t toDayNumber(int year, int month, int day) {
+        year -= month <= 2;
+        int era = (year >= 0 ? year : year - 399) / 400;
+        int yearOfEra = year - era * 400;
+        int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    // Inverse of toDayNumber; fills year, month and day
+    constexpr void toCivil(int& year, int& month, int& day) const {
+        int32_t z = days + 719468;
+        int era = (z >= 0 ? z : z - 146096) / 146097;
+        int dayOfEra = z - era * 146097;
+        int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        int shiftedMonth = (5 * dayOfYear + 2) / 153;
+        day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+        month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+        year = yearOfEra + era * 400 + (month <= 2);
+    }
+
+public:
+    constexpr Date() : days(INVALID_DAY) {}
+    constexpr explicit Date(int32_t dayNumber) : days(dayNumber) {}
+
+    // Builds a date from its parts; returns an invalid Date if they do not form a real day
+    static constexpr Date fromCivil(int year, int month, int day) {
+        if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+            return Date();
+        }
+        return Date(toDayNumber(year, month, day));
+    }
+
+    // Parses DD/MM/YYYY; returns an invalid Date on any format or calendar error
+    static constexpr Date parse(string_view text) {
+        if (text.size() != 10 || text[2] != '/' || text[5] != '/') {
+            return Date();
+        }
+        int values[8] = {};
+        constexpr int positions[8] = {0, 1, 3, 4, 6, 7, 8, 9};
+        for (int i = 0; i < 8; i++) {
+            values[i] = digit(text[positions[i]]);
+            if (values[i] < 0) {
+                return Date();
+            }
+        }
+        int day = values[0] * 10 + values[1];
+        int month = values[2] * 10 + values[3];
+        int year = values[4] * 1000 + values[5] * 100 + values[6] * 10 + values[7];
+        return fromCivil(year, month, day);
+    }
+
+    constexpr bool isValid() const { return days != INVALID_DAY; }
+    constexpr int32_t dayNumber() const { return days; }
+
+    constexpr int year() const { int y = 0, m = 0, d = 0; toCivil(y, m, d); return y; }
+    constexpr int month() const { int y = 0, m = 0, d = 0; toCivil(y, m, d); return m; }
+    constexpr int day() const { int y = 0, m = 0, d = 0; toCivil(y, m, d); return d; }
+
+    // Writes DD/MM/YYYY into out (10 characters, not terminated); invalid dates write nothing
+    constexpr size_t format(char* out) const {
+        if (!isValid()) {
+            return 0;
+        }
+        int y = 0, m = 0, d = 0;
+        toCivil(y, m, d);
+        out[0] = static_cast<char>('0' + d / 10);
+        out[1] = static_cast<char>('0' + d % 10);
+        out[2] = '/';
+        out[3] = static_cast<char>('0' + m / 10);
+        out[4] = static_cast<char>('0' + m % 10);
+        out[5] = '/';
+        out[6] = static_cast<char>('0' + y / 1000 % 10);
+        out[7] = static_cast<char>('0' + y / 100 % 10);
+        out[8] = static_cast<char>('0' + y / 10 % 10);
+        out[9] = static_cast<char>('0' + y % 10);
+        return 10;
+    }
+
+    string toString() const {
+        char buffer[10] = {};
+        return string(buffer, format(buffer));
+    }
+
+    // Day arithmetic
+    constexpr int operator-(const Date& other) const { return days - other.days; }
+    constexpr Date operator+(int offset) const { return Date(days + offset); }
+
+    constexpr bool operator==(const Date& other) const { return days == other.days; }
+    constexpr bool operator!=(const Date& other) const { return days != other.days; }
+    constexpr bool operator<(const Date& other) const { return days < other.days; }
+    constexpr bool operator<=(const Date& other) const { return days <= other.days; }
+    constexpr bool operator>(const Date& other) const { return days > other.days; }
+    constexpr bool operator>=(const Date& other) const { return days >= other.days; }
+};
+
+static_assert(Date::parse("01/01/1970").dayNumber() == 0, "Date epoch mismatch");
+static_assert(Date::parse("29/02/2024").isValid() && !Date::parse("29/02/2025").isValid(),
+              "Date leap year handling");
+static_assert(Date::parse("01/03/2025") - Date::parse("28/02/2025") == 1, "Date month rollover");
+
+#endif
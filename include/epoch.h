@@ -0,0 +1,114 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Epoch-based reclamation for objects handed to lock-free readers, in the
+// style of userspace RCU. A reading thread pins the current epoch while it
+// holds an EpochGuard; that is one store to a slot of its own, so readers
+// never contend with each other or wait for the writer. An object the writer
+// replaces is retired with the epoch that followed the replacement and is
+// deleted once no reader still pins an earlier epoch.
+//
+// Up to MAX_READER_THREADS threads can hold guards at once; a thread claims
+// a slot on its first guard and gives it back when it exits.
+
+const size_t MAX_READER_THREADS = 256;
+
+// Pins the current epoch for the calling thread; guards may nest
+class EpochGuard {
+public:
+    EpochGuard();
+    ~EpochGuard();
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+// Starts a new epoch and returns it
+uint64_t advanceEpoch();
+
+// Earliest epoch pinned by any reader, or UINT64_MAX when none is reading.
+// An object retired at epoch e is unreachable once this is at least e.
+uint64_t oldestPinnedEpoch();
+
+// One object published by a single writer thread to any number of readers.
+// read() never blocks; publish() swaps the object and frees the ones no
+// reader can still see. T may be incomplete where only read() is used.
+template <typename T>
+class Published {
+private:
+    atomic<const T*> current;
+    vector<pair<uint64_t, const T*>> retired;  // Replaced objects and their retirement epoch
+
+    void reclaim(uint64_t oldestPinned) {
+        size_t kept = 0;
+        for (const pair<uint64_t, const T*>& entry : retired) {
+            if (entry.first <= oldestPinned) {
+                delete entry.second;
+            } else {
+                retired[kept++] = entry;
+            }
+        }
+        retired.resize(kept);
+    }
+
+public:
+    // The object current when the pin was taken; it stays valid, and
+    // unchanged, for as long as the pin is in scope
+    class Pin {
+    private:
+        EpochGuard guard;   // Pinned before the object is loaded
+        const T* object;
+
+    public:
+        explicit Pin(const Published& published) : object(published.current.load()) {}
+
+        const T& operator*() const { return *object; }
+        const T* operator->() const { return object; }
+        const T* get() const { return object; }
+    };
+
+    Published() : current(nullptr) {}
+    Published(const Published&) = delete;
+    Published& operator=(const Published&) = delete;
+
+    // Waits for readers of the retired objects; must not run while the
+    // calling thread holds a Pin
+    ~Published() {
+        const T* last = current.exchange(nullptr);
+        if (last) {
+            retired.emplace_back(advanceEpoch(), last);
+        }
+        while (!retired.empty()) {
+            reclaim(oldestPinnedEpoch());
+            if (!retired.empty()) {
+                this_thread::yield();
+            }
+        }
+    }
+
+    // Any thread
+    Pin read() const { return Pin(*this); }
+
+    // Writer thread only: next becomes current, and every retired object
+    // that no reader can still see is deleted
+    void publish(unique_ptr<const T> next) {
+        const T* previous = current.exchange(next.release());
+        if (previous) {
+            retired.emplace_back(advanceEpoch(), previous);
+        }
+        reclaim(oldestPinnedEpoch());
+    }
+
+    // Objects replaced but still visible to some reader
+    size_t retiredCount() const { return retired.size(); }
+};
+
+#endif
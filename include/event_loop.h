@@ -0,0 +1,47 @@
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+using namespace std;
+
+// Level-triggered epoll loop (Linux only). Each registered descriptor has one
+// handler that is called with the ready epoll events (EPOLLIN, EPOLLOUT,
+// EPOLLHUP, ...). Handlers run on the thread that called run() and may add,
+// modify or remove descriptors, including their own, while being called.
+class EventLoop {
+public:
+    typedef function<void(uint32_t events)> Handler;
+
+private:
+    int epollFd;
+    int wakeFd;                 // eventfd written by stop() to interrupt epoll_wait
+    atomic<bool> stopping;
+    // shared_ptr so a handler that removes itself is not destroyed mid-call
+    unordered_map<int, shared_ptr<Handler>> handlers;
+
+public:
+    EventLoop();
+    ~EventLoop();
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    bool isValid() const { return epollFd >= 0 && wakeFd >= 0; }
+
+    // The loop does not own fd; the caller closes it after remove()
+    bool add(int fd, uint32_t events, Handler handler);
+    bool modify(int fd, uint32_t events);
+    void remove(int fd);
+    size_t size() const { return handlers.size(); }
+
+    // Dispatches events until stop() is called
+    void run();
+    // Safe to call from another thread or a signal handler
+    void stop();
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef FILE_LOADER_H
+#define FILE_LOADER_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+using namespace std;
+
+// Read-only view of a whole data file. Uses mmap on POSIX systems and
+// falls back to reading the file into memory elsewhere.
+class MappedFile {
+private:
+    const char* data;
+    size_t length;
+    string buffer;      // Only used by the non-mmap fallback
+    bool mapped;
+    bool opened;
+
+public:
+    explicit MappedFile(const string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return opened; }
+    string_view view() const { return string_view(data, length); }
+};
+
+// Pipe-delimited record parsing shared by the Auth and BookingManager loaders.
+// Fields are slices of the input, so nothing is copied until a record is built.
+const size_t MAX_RECORD_FIELDS = 16;
+
+string_view trimField(string_view field);
+size_t splitRecord(string_view line, string_view* fields, size_t maxFields);
+double parseDouble(string_view field, double fallback = 0.0);
+size_t countLines(string_view text); // Upper bound on record count, used to reserve capacity
+
+// Calls fn(fields, count) for every non-blank, non-comment line in text
+template <typename Fn>
+void forEachRecord(string_view text, Fn&& fn) {
+    string_view fields[MAX_RECORD_FIELDS];
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == string_view::npos) end = text.size();
+
+        string_view line = trimField(text.substr(pos, end - pos));
+        pos = end + 1;
+
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t count = splitRecord(line, fields, MAX_RECORD_FIELDS);
+        fn(fields, count);
+    }
+}
+
+#endif
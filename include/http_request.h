@@ -0,0 +1,58 @@
+#ifndef HTTP_REQUEST_H
+#define HTTP_REQUEST_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+const size_t MAX_HTTP_HEAD_SIZE = 8 * 1024;     // Request line and headers
+const size_t MAX_HTTP_BODY_SIZE = 64 * 1024;
+const size_t MAX_HTTP_HEADERS = 32;
+
+struct HttpHeader {
+    string_view name;
+    string_view value;
+};
+
+// One HTTP/1.x request parsed in place: every field is a view into the
+// receive buffer it was parsed from and is valid until that buffer changes
+struct HttpRequest {
+    string_view method;
+    string_view path;           // Target up to '?'
+    string_view query;          // Target after '?', without it
+    int minorVersion = 1;       // HTTP/1.<minorVersion>
+    HttpHeader headers[MAX_HTTP_HEADERS];
+    size_t headerCount = 0;
+    string_view body;
+    size_t length = 0;          // Bytes of the buffer this request occupies
+    bool keepAlive = true;
+
+    // Value of the first header called name (case-insensitive), or empty
+    string_view header(string_view name) const;
+};
+
+enum class HttpParseStatus {
+    Complete,
+    Incomplete,                 // Need more bytes
+    BadRequest,                 // 400
+    BodyTooLarge,               // 413
+    HeadersTooLarge,            // 431
+    NotImplemented,             // 501: Transfer-Encoding
+    VersionNotSupported         // 505
+};
+
+// Parses the request at the front of input; on Complete, request.length
+// bytes belong to it and any remainder is the next pipelined request
+HttpParseStatus parseHttpRequest(string_view input, HttpRequest& request);
+
+// Looks up name in an application/x-www-form-urlencoded string (a query or
+// a form body). The value is returned as a view into form unless it is
+// percent- or plus-encoded, in which case it is decoded into storage.
+bool formValue(string_view form, string_view name, string& storage, string_view& value);
+
+// Decodes standard base64; false on malformed input
+bool decodeBase64(string_view text, string& decoded);
+
+#endif
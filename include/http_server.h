@@ -0,0 +1,65 @@
+#ifndef HTTP_SERVER_H
+#define HTTP_SERVER_H
+
+#include "socket_server.h"
+#include "http_request.h"
+#include "booking.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+class Auth;
+class JsonWriter;
+class User;
+
+// HTTP/1.1 JSON API over the same Auth and BookingManager as the console
+// and binary servers (Linux only). Connections are kept alive and pipelined
+// requests are answered in order. Requests are parsed in place from the
+// receive buffer and JSON is written straight into the send buffer.
+//
+//   GET  /api/motorbikes?start=&end=&city=&sort=price|rating|total&limit=&afterKey=&afterSlot=
+//   GET  /api/bookings                     The caller's bookings
+//   GET  /api/requests                     Pending requests on the caller's motorbikes
+//   POST /api/bookings                     motorbikeId, start, end (form body or query)
+//   POST /api/bookings/{id}/approve
+//   POST /api/bookings/{id}/reject
+//   GET  /api/admin/statistics             Admin credentials required
+//
+// Every route needs HTTP Basic credentials of a member (or of an admin for
+// the statistics). Dates are DD/MM/YYYY. Errors are {"error": message}.
+class HttpServer : public SocketServer {
+private:
+    // Position of a response whose body is still being written
+    struct Response {
+        size_t lengthField;     // Offset of the padded Content-Length value
+        size_t bodyStart;
+    };
+
+    Auth& auth;
+    BookingManager& bookingManager;
+    vector<const Booking*> bookingScratch;
+
+    size_t handleInput(Connection& connection) override;
+    void handleRequest(Connection& connection, const HttpRequest& request);
+    void handleSearch(Connection& connection, const HttpRequest& request, const User& user);
+    void handleCreateBooking(Connection& connection, const HttpRequest& request, const User& user);
+    void handleBookingList(Connection& connection, const HttpRequest& request, const User& user,
+                           bool rentalRequests);
+    void handleDecision(Connection& connection, const HttpRequest& request, const User& user,
+                        string_view bookingId, bool approve);
+    void handleStatistics(Connection& connection, const HttpRequest& request);
+    const User* authenticate(const HttpRequest& request, bool admin);
+
+    Response beginResponse(Connection& connection, int status, bool keepAlive,
+                           string_view extraHeaders = string_view());
+    void endResponse(Connection& connection, const Response& response);
+    void sendError(Connection& connection, int status, string_view message, bool keepAlive,
+                   string_view extraHeaders = string_view());
+
+public:
+    HttpServer(EventLoop& loop, Auth& auth, BookingManager& bookingManager);
+};
+
+#endif
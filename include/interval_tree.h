@@ -0,0 +1,173 @@
+#ifndef INTERVAL_TREE_H
+#define INTERVAL_TREE_H
+
+#include <memory>
+#include <algorithm>
+#include <cstddef>
+
+using namespace std;
+
+// Balanced (AVL) interval tree of closed intervals [low, high], each tagged
+// with a value. Nodes are ordered by (low, value) and carry the largest high
+// in their subtree, so overlap queries only descend into subtrees that can
+// contain a match.
+//   overlaps       - O(log n)
+//   forEachOverlap - O(log n + matches)
+//   insert / erase - O(log n)
+template <typename Key, typename Value>
+class IntervalTree {
+private:
+    struct Node {
+        Key low;
+        Key high;
+        Key maxHigh;
+        Value value;
+        int height;
+        unique_ptr<Node> left;
+        unique_ptr<Node> right;
+
+        Node(const Key& low, const Key& high, const Value& value)
+            : low(low), high(high), maxHigh(high), value(value), height(1) {}
+    };
+
+    unique_ptr<Node> root;
+    size_t count = 0;
+
+    static int heightOf(const unique_ptr<Node>& node) { return node ? node->height : 0; }
+
+    static void update(Node* node) {
+        node->height = 1 + max(heightOf(node->left), heightOf(node->right));
+        node->maxHigh = node->high;
+        if (node->left && node->maxHigh < node->left->maxHigh) node->maxHigh = node->left->maxHigh;
+        if (node->right && node->maxHigh < node->right->maxHigh) node->maxHigh = node->right->maxHigh;
+    }
+
+    static unique_ptr<Node> rotateRight(unique_ptr<Node> node) {
+        unique_ptr<Node> pivot = move(node->left);
+        node->left = move(pivot->right);
+        update(node.get());
+        pivot->right = move(node);
+        update(pivot.get());
+        return pivot;
+    }
+
+    static unique_ptr<Node> rotateLeft(unique_ptr<Node> node) {
+        unique_ptr<Node> pivot = move(node->right);
+        node->right = move(pivot->left);
+        update(node.get());
+        pivot->left = move(node);
+        update(pivot.get());
+        return pivot;
+    }
+
+    static unique_ptr<Node> rebalance(unique_ptr<Node> node) {
+        update(node.get());
+        int balance = heightOf(node->left) - heightOf(node->right);
+        if (balance > 1) {
+            if (heightOf(node->left->left) < heightOf(node->left->right)) {
+                node->left = rotateLeft(move(node->left));
+            }
+            return rotateRight(move(node));
+        }
+        if (balance < -1) {
+            if (heightOf(node->right->right) < heightOf(node->right->left)) {
+                node->right = rotateRight(move(node->right));
+            }
+            return rotateLeft(move(node));
+        }
+        return node;
+    }
+
+    static bool before(const Key& low, const Value& value, const Node* node) {
+        return low < node->low || (!(node->low < low) && value < node->value);
+    }
+
+    static unique_ptr<Node> insert(unique_ptr<Node> node, unique_ptr<Node> fresh) {
+        if (!node) return fresh;
+        if (before(fresh->low, fresh->value, node.get())) {
+            node->left = insert(move(node->left), move(fresh));
+        } else {
+            node->right = insert(move(node->right), move(fresh));
+        }
+        return rebalance(move(node));
+    }
+
+    static unique_ptr<Node> removeMin(unique_ptr<Node> node, unique_ptr<Node>& minNode) {
+        if (!node->left) {
+            unique_ptr<Node> right = move(node->right);
+            minNode = move(node);
+            return right;
+        }
+        node->left = removeMin(move(node->left), minNode);
+        return rebalance(move(node));
+    }
+
+    static unique_ptr<Node> erase(unique_ptr<Node> node, const Key& low, const Value& value, bool& erased) {
+        if (!node) return node;
+        if (before(low, value, node.get())) {
+            node->left = erase(move(node->left), low, value, erased);
+        } else if (low < node->low || node->low < low || node->value < value) {
+            node->right = erase(move(node->right), low, value, erased);
+        } else {
+            erased = true;
+            if (!node->left) return move(node->right);
+            if (!node->right) return move(node->left);
+
+            unique_ptr<Node> successor;
+            unique_ptr<Node> right = removeMin(move(node->right), successor);
+            successor->left = move(node->left);
+            successor->right = move(right);
+            return rebalance(move(successor));
+        }
+        return rebalance(move(node));
+    }
+
+    template <typename Fn>
+    static void visitOverlaps(const Node* node, const Key& low, const Key& high, Fn& fn) {
+        if (!node || node->maxHigh < low) return;
+        visitOverlaps(node->left.get(), low, high, fn);
+        if (high < node->low) return; // Everything to the right starts even later
+        if (!(node->high < low)) fn(node->low, node->high, node->value);
+        visitOverlaps(node->right.get(), low, high, fn);
+    }
+
+public:
+    void insert(const Key& low, const Key& high, const Value& value) {
+        root = insert(move(root), unique_ptr<Node>(new Node(low, high, value)));
+        count++;
+    }
+
+    // Removes the interval starting at low tagged with value
+    bool erase(const Key& low, const Value& value) {
+        bool erased = false;
+        root = erase(move(root), low, value, erased);
+        if (erased) count--;
+        return erased;
+    }
+
+    // True if any stored interval intersects [low, high]
+    bool overlaps(const Key& low, const Key& high) const {
+        const Node* node = root.get();
+        while (node) {
+            if (!(high < node->low) && !(node->high < low)) return true;
+            // If the left subtree reaches low, any overlap must be there
+            if (node->left && !(node->left->maxHigh < low)) {
+                node = node->left.get();
+            } else {
+                node = node->right.get();
+            }
+        }
+        return false;
+    }
+
+    // Calls fn(low, high, value) for every stored interval intersecting [low, high]
+    template <typename Fn>
+    void forEachOverlap(const Key& low, const Key& high, Fn fn) const {
+        visitOverlaps(root.get(), low, high, fn);
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+#endif
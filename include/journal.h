@@ -0,0 +1,82 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+using namespace std;
+
+// Append-only file of newline-terminated records that several threads write
+// with one write and one disk sync between them (group commit).
+//
+// A writer calls append() while it still holds the lock that orders its
+// change, which gives the records a sequence number in that order and costs
+// no I/O. It then releases that lock and calls commit(sequence): the first
+// thread to get the file writes every record appended so far and syncs it,
+// and the threads queued behind it usually find theirs already written.
+//
+// An append of several records is written as one group, "B|count" followed
+// by the records, and replay() skips a group that a crash cut short: the
+// records of one append are kept together or not at all.
+//
+// Appended records are kept in memory until the owner folds them into its
+// data files and calls rewrite(), so a rewrite can carry the newer ones over.
+class Journal {
+private:
+    struct Entry {
+        uint64_t sequence;
+        string records;
+        int count;
+    };
+
+    string filename;
+    string header;              // First line of the file, without the newline
+    int fd;                     // Open for appending, -1 = not open
+    atomic<bool> opened;        // Readable without fileMutex
+    mutex fileMutex;            // fd and written
+    uint64_t written;           // Every sequence up to here is in the file
+    mutex tailMutex;            // entries and appended
+    deque<Entry> entries;       // Appended since the last rewrite, in sequence order
+    uint64_t appended;
+    atomic<int> recordCount;    // Records in the file plus those not yet written
+
+public:
+    Journal(string filename, string header);
+    ~Journal();
+
+    // Opens the file for appending, writing the header to a new one;
+    // existingRecords is how many records replay found in it
+    bool open(int existingRecords);
+    bool isOpen() const { return opened.load(); }
+    const string& getFilename() const { return filename; }
+
+    // Queues count records and returns their sequence number, or 0 when the
+    // file is not open. No I/O; safe to call with other locks held.
+    uint64_t append(const string& records, int count);
+
+    // Returns once every record up to sequence is in the file and synced to
+    // the disk, or false when that write failed; the failed records stay
+    // queued and the next commit writes them again. Call without holding
+    // locks that appending threads need.
+    bool commit(uint64_t sequence);
+
+    uint64_t lastSequence();
+    int records() const { return recordCount.load(); }
+
+    // Replaces the file with carried followed by every record appended after
+    // sequence through; the owner has saved the effect of the records up to
+    // through elsewhere. Earlier records are written first, so a crash part
+    // way leaves either the old file or the new one.
+    bool rewrite(const string& carried, int carriedCount, uint64_t through);
+
+    // Calls apply(line) for each record of a journal file in order, leaving
+    // out comments, group lines and any record of an incomplete group or
+    // line at the end of the file
+    static void replay(const string& filename, const function<void(const string&)>& apply);
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+class Date;
+
+// Appends JSON straight onto an output buffer (typically a connection's
+// send buffer), so records are serialised without building intermediate
+// strings. Commas are inserted automatically; nesting is limited to 64
+// levels. Numbers use the shortest round-trip form; NaN and infinities
+// become null.
+class JsonWriter {
+private:
+    string& out;
+    uint64_t hasItems;      // Bit d: the container at depth d already has a value
+    int depth;
+    bool afterKey;          // The next value is a member value and takes no comma
+
+    void separate();
+
+public:
+    explicit JsonWriter(string& out);
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+    JsonWriter& key(string_view name);      // Next value belongs to this member
+
+    JsonWriter& value(string_view text);
+    JsonWriter& value(const char* text) { return value(string_view(text)); }
+    JsonWriter& value(double number);
+    JsonWriter& value(int64_t number);
+    JsonWriter& value(size_t number) { return value(static_cast<int64_t>(number)); }
+    JsonWriter& value(int number) { return value(static_cast<int64_t>(number)); }
+    JsonWriter& value(bool flag);
+    JsonWriter& value(Date date);           // "DD/MM/YYYY", null if invalid
+    JsonWriter& null();
+
+    // key(name).value(v) in one call
+    template <typename T>
+    JsonWriter& member(string_view name, const T& v) { return key(name).value(v); }
+};
+
+#endif
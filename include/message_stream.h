@@ -0,0 +1,34 @@
+#ifndef MESSAGE_STREAM_H
+#define MESSAGE_STREAM_H
+
+#include <ostream>
+
+using namespace std;
+
+// Stream that Auth, BookingManager and the records they hold write their
+// user-facing messages to. It is cout unless redirected; embedders and
+// benchmarks can pass a log file, or an ostream with a null buffer to
+// discard everything. The stream must outlive its use by the engine.
+ostream& messageStream();
+void setMessageStream(ostream& stream);
+
+// Stream for the calling thread only, overriding the shared one; nullptr
+// goes back to it. Threads calling the engine at the same time each need
+// their own, since an ostream must not be written from two threads at once.
+ostream* threadMessageStream();
+void setThreadMessageStream(ostream* stream);
+
+// Redirects the calling thread's engine messages to stream until it goes
+// out of scope
+class ScopedMessageStream {
+private:
+    ostream* previous;
+
+public:
+    explicit ScopedMessageStream(ostream& stream) : previous(threadMessageStream()) { setThreadMessageStream(&stream); }
+    ~ScopedMessageStream() { setThreadMessageStream(previous); }
+    ScopedMessageStream(const ScopedMessageStream&) = delete;
+    ScopedMessageStream& operator=(const ScopedMessageStream&) = delete;
+};
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef MOTORBIKE_CATALOG_H
+#define MOTORBIKE_CATALOG_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <memory>
+
+using namespace std;
+
+class Motorbike;
+
+// The AVX2 kernel is compiled on x86 with GCC or Clang whatever the target
+// flags (it carries its own target attribute); select() runs it only on a
+// CPU that reports AVX2
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define EMR_AVX2_KERNEL 1
+#endif
+
+// Filter evaluated by MotorbikeCatalog::select. A row matches when the
+// motorbike is listed and available in cityId, its availability window
+// covers [startDay, endDay], renterRating meets its minimum, renting it for
+// rentalDays costs no more than renterCredits and its engine is at most
+// maxEngineCc. With requireFree set, the motorbike must also have no
+// approved booking on any day of [startDay, endDay].
+struct CatalogQuery {
+    uint32_t cityId;
+    int32_t startDay;
+    int32_t endDay;
+    double rentalDays;
+    double renterRating;
+    double renterCredits;
+    int32_t maxEngineCc = INT32_MAX;
+    bool requireFree = false;
+};
+
+// Struct-of-arrays copy of the motorbike fields the search path filters on.
+// Row i mirrors slot i of BookingManager::motorbikes, and BookingManager calls
+// set() whenever one of these fields changes. select() scans the columns
+// eight rows at a time with AVX2 when the CPU has it, checked once at run
+// time, and with a scalar loop otherwise.
+//
+// Rows live in blocks of BLOCK_ROWS that copies of the catalog share, like
+// CowTable pages: a copy is an immutable view for snapshot searches
+// (BookingSnapshot) and costs O(blocks), and set()/setOccupied() clone a
+// block before changing it if a copy still shares it.
+class MotorbikeCatalog {
+private:
+    static const size_t BLOCK_BITS = 10;
+    static const size_t BLOCK_ROWS = size_t(1) << BLOCK_BITS;  // Whole selection words per block
+
+    struct Block {
+        vector<uint32_t> keys;              // cityId << 2 | LISTED | AVAILABLE, one compare per row
+        vector<double> prices;
+        vector<double> minRenterRatings;
+        vector<int32_t> engineCcs;
+        vector<int32_t> startDays;          // Availability window, Date::dayNumber()
+        vector<int32_t> endDays;
+
+        // Day occupancy: bit d of a row's words is set when day startDays[row] + d
+        // has an approved booking. The block's rows share one contiguous word arena.
+        vector<uint64_t> occupancyWords;
+        vector<uint32_t> occupancyOffsets;  // First word of each row in occupancyWords
+        vector<uint32_t> occupancyLengths;  // Words per row, 0 when the window is invalid
+
+        bool clipToWindow(size_t row, int32_t& first, int32_t& last) const;
+        bool isFree(size_t row, int32_t firstDay, int32_t lastDay) const;
+        unsigned freeRows(size_t row, unsigned mask, int32_t firstDay, int32_t lastDay) const;
+        void selectScalar(const CatalogQuery& query, size_t first, uint64_t* words) const;
+#ifdef EMR_AVX2_KERNEL
+        size_t selectAVX2(const CatalogQuery& query, uint64_t* words) const;
+#endif
+    };
+
+    vector<shared_ptr<Block>> blocks;
+    size_t rows = 0;
+
+    const Block& blockOf(size_t row) const { return *blocks[row >> BLOCK_BITS]; }
+    static size_t rowInBlock(size_t row) { return row & (BLOCK_ROWS - 1); }
+    Block& writableBlock(size_t row);
+
+public:
+    static const uint32_t LISTED = 1;
+    static const uint32_t AVAILABLE = 2;
+
+    // Copies the filter fields of motorbike into row; row == size() appends.
+    // Returns true if the row's occupancy was reset (new row or new window),
+    // in which case the caller re-marks its approved bookings.
+    bool set(size_t row, const Motorbike& motorbike);
+    void reserve(size_t rows);
+    size_t size() const { return rows; }
+
+    // Row fields that decide which cached searches a row can appear in
+    uint32_t cityId(size_t row) const { return blockOf(row).keys[rowInBlock(row)] >> 2; }
+    int32_t startDay(size_t row) const { return blockOf(row).startDays[rowInBlock(row)]; }
+    int32_t endDay(size_t row) const { return blockOf(row).endDays[rowInBlock(row)]; }
+
+    // The per-renter part of the filter: engine size, rating and cost only
+    bool matchesRenter(size_t row, const CatalogQuery& query) const {
+        const Block& block = blockOf(row);
+        size_t i = rowInBlock(row);
+        return block.engineCcs[i] <= query.maxEngineCc &&
+               block.minRenterRatings[i] <= query.renterRating &&
+               block.prices[i] * query.rentalDays <= query.renterCredits;
+    }
+
+    // Day occupancy inside a row's availability window; days outside it are ignored
+    void setOccupied(size_t row, int32_t firstDay, int32_t lastDay, bool occupied);
+    void clearOccupancy(size_t row);
+    bool isFree(size_t row, int32_t firstDay, int32_t lastDay) const {
+        return blockOf(row).isFree(rowInBlock(row), firstDay, lastDay);
+    }
+
+    // Sets bit i of selection (word i / 64) for every matching row i and
+    // returns the number of matches
+    size_t select(const CatalogQuery& query, vector<uint64_t>& selection) const;
+    static bool usesAVX2();     // Which kernel select() runs on this machine
+
+    // Calls fn(row) for every set bit, in row order
+    template <typename Fn>
+    static void forEachSelected(const vector<uint64_t>& selection, Fn fn) {
+        for (size_t word = 0; word < selection.size(); word++) {
+            uint64_t bits = selection[word];
+            while (bits) {
+                fn(word * 64 + __builtin_ctzll(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+};
+
+#endif
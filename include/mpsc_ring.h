@@ -0,0 +1,94 @@
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+using namespace std;
+
+// Bounded lock-free queue for many producer threads and one consumer
+// thread (after Vyukov's bounded MPMC queue). Each cell carries a sequence
+// number telling whose turn it is: a producer claims a position with one
+// compare-and-swap on tail, fills the cell and publishes it by bumping the
+// sequence; the consumer takes cells strictly in claim order, so items come
+// out in the order their positions were claimed.
+//   tryPush - lock-free, any thread; false when the ring is full
+//   tryPop  - wait-free, the consumer thread only; false when the next item
+//             is not (yet) published
+template <typename T>
+class MpscRing {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        T value;
+    };
+
+    unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) atomic<size_t> tail;    // Next position to claim (producers)
+    alignas(64) size_t head;            // Next position to take (consumer)
+
+    static size_t roundUp(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+public:
+    // Capacity is rounded up to a power of two
+    explicit MpscRing(size_t capacity)
+        : cells(new Cell[roundUp(capacity)]), mask(roundUp(capacity) - 1), tail(0), head(0) {
+        for (size_t i = 0; i <= mask; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // Moves value in and returns true, or leaves it alone if the ring is full
+    bool tryPush(T& value) {
+        size_t position = tail.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(memory_order_acquire);
+            intptr_t lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (lag == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    cell.value = move(value);
+                    cell.sequence.store(position + 1, memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;   // The consumer has not taken this cell's previous item yet
+            } else {
+                position = tail.load(memory_order_relaxed);     // Another producer claimed it
+            }
+        }
+    }
+
+    bool tryPop(T& value) {
+        Cell& cell = cells[head & mask];
+        if (cell.sequence.load(memory_order_acquire) != head + 1) {
+            return false;
+        }
+        value = move(cell.value);
+        cell.sequence.store(head + mask + 1, memory_order_release);
+        head++;
+        return true;
+    }
+
+    // Consumer thread only: true if tryPop would fail now
+    bool empty() const {
+        return cells[head & mask].sequence.load(memory_order_acquire) != head + 1;
+    }
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+// Binary protocol of the booking server (booking_server.h).
+//
+// Every message is one frame: a u32 payload length followed by the payload.
+// A request payload starts with a u8 Opcode and a response payload with a
+// u8 ResponseStatus; the fields listed below follow. Integers are
+// little-endian, doubles are IEEE-754 binary64 sent as a little-endian u64,
+// and strings are a u16 byte count followed by the bytes. Responses come
+// back in request order, so a client may pipeline any number of requests.
+//
+//   Login        username, password         -> fullName, creditPoints, rating
+//   Logout                                  -> (empty)
+//   Search       startDate, endDate ("" for one day), city, u8 SearchSortKey,
+//                u32 limit, cursor          -> u32 totalMatches, u8 hasMore,
+//                cursor, u32 count, count x motorbike
+//   Book         motorbikeId, startDate, endDate
+//                                           -> bookingId, totalCost
+//   Requests                                -> u32 count, count x booking
+//   Bookings                                -> u32 count, count x booking
+//   Approve      bookingId                  -> (empty)
+//   Reject       bookingId                  -> (empty)
+//   Profile                                 -> username, fullName, email,
+//                phoneNumber, idType, licenseNumber, licenseExpiry,
+//                creditPoints, rating
+//
+//   cursor       u8 valid, double key, u32 slot (SearchCursor)
+//   motorbike    motorbikeId, brand, model, color, size, location,
+//                pricePerDay, rating
+//   booking      bookingId, renterUsername, motorbikeId, startDate, endDate,
+//                totalCost, status
+//
+// Every operation except Login needs a logged-in connection. An Error
+// response carries a u8 BookingError (None unless the failure came from
+// booking rules) and a message string.
+
+const uint32_t MAX_FRAME_SIZE = 64 * 1024;   // Larger frames close the connection
+const size_t FRAME_HEADER_SIZE = 4;
+
+enum class Opcode : uint8_t {
+    Login = 1,
+    Logout,
+    Search,
+    Book,
+    Requests,
+    Bookings,
+    Approve,
+    Reject,
+    Profile
+};
+
+enum class ResponseStatus : uint8_t {
+    Ok = 0,
+    Error,
+    NotLoggedIn,
+    BadRequest
+};
+
+// Appends one frame to a buffer; the length prefix is filled in by finish()
+class FrameWriter {
+private:
+    string& buffer;
+    size_t start;
+
+public:
+    explicit FrameWriter(string& buffer);
+
+    FrameWriter& u8(uint8_t value);
+    FrameWriter& u16(uint16_t value);
+    FrameWriter& u32(uint32_t value);
+    FrameWriter& f64(double value);
+    FrameWriter& str(string_view value);     // Truncated to 65535 bytes
+    void finish();
+};
+
+// Reads the fields of one payload; any read past the end marks it invalid
+// and returns zero or an empty string from then on
+class FrameReader {
+private:
+    const char* data;
+    size_t size;
+    size_t position;
+    bool valid;
+
+    bool take(size_t bytes);
+
+public:
+    explicit FrameReader(string_view payload);
+
+    uint8_t u8();
+    uint16_t u16();
+    uint32_t u32();
+    double f64();
+    string_view str();
+
+    bool isValid() const { return valid; }
+    bool atEnd() const { return position == size; }
+};
+
+// Length of the frame whose header starts at data, or 0 if fewer than
+// FRAME_HEADER_SIZE bytes are available
+uint32_t frameLength(const char* data, size_t available);
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef RECORD_VIEW_H
+#define RECORD_VIEW_H
+
+#include <cstddef>
+#include <iterator>
+
+using namespace std;
+
+template <typename Container, typename Predicate> class FilteredRange;
+
+// Read-only view of a record table (vector, deque or CowTable) that iterates and
+// indexes the records in place instead of copying them. A view is only valid
+// until the table it looks at is next modified.
+template <typename Container>
+class RecordSpan {
+private:
+    const Container* records;
+
+public:
+    typedef typename Container::value_type value_type;
+    typedef typename Container::const_iterator iterator;
+
+    explicit RecordSpan(const Container& records) : records(&records) {}
+
+    iterator begin() const { return records->begin(); }
+    iterator end() const { return records->end(); }
+    size_t size() const { return records->size(); }
+    bool empty() const { return records->empty(); }
+    const value_type& operator[](size_t index) const { return (*records)[index]; }
+
+    // The records for which predicate(record) is true, skipped over lazily
+    template <typename Predicate>
+    FilteredRange<Container, Predicate> where(Predicate predicate) const {
+        return FilteredRange<Container, Predicate>(*this, predicate);
+    }
+};
+
+// Records of a RecordSpan that satisfy a predicate; iterating visits only
+// the matching records and copies none of them
+template <typename Container, typename Predicate>
+class FilteredRange {
+private:
+    RecordSpan<Container> records;
+    Predicate predicate;
+
+public:
+    typedef typename Container::value_type value_type;
+
+    class iterator {
+    private:
+        typename Container::const_iterator current;
+        typename Container::const_iterator last;
+        const Predicate* predicate;
+
+        void skip() {
+            while (current != last && !(*predicate)(*current)) {
+                ++current;
+            }
+        }
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef typename Container::value_type value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef const value_type& reference;
+
+        iterator(typename Container::const_iterator current, typename Container::const_iterator last,
+                 const Predicate* predicate)
+            : current(current), last(last), predicate(predicate) {
+            skip();
+        }
+
+        reference operator*() const { return *current; }
+        pointer operator->() const { return &*current; }
+        iterator& operator++() { ++current; skip(); return *this; }
+        iterator operator++(int) { iterator old = *this; ++*this; return old; }
+        bool operator==(const iterator& other) const { return current == other.current; }
+        bool operator!=(const iterator& other) const { return current != other.current; }
+    };
+
+    FilteredRange(const RecordSpan<Container>& records, Predicate predicate)
+        : records(records), predicate(predicate) {}
+
+    iterator begin() const { return iterator(records.begin(), records.end(), &predicate); }
+    iterator end() const { return iterator(records.end(), records.end(), &predicate); }
+    bool empty() const { return begin() == end(); }
+
+    // Number of matching records; walks the whole table
+    size_t count() const {
+        size_t matches = 0;
+        for (iterator it = begin(); it != end(); ++it) {
+            matches++;
+        }
+        return matches;
+    }
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef SEARCH_CACHE_H
+#define SEARCH_CACHE_H
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Bounded LRU cache of renter-independent search candidates: the motorbike
+// slots that are listed, available and free in a city for a date window.
+// Per-renter checks (rating, credits, engine size) run on top of a hit.
+// Entries are dropped selectively when a motorbike in the same city whose
+// availability window covers the cached dates changes.
+class SearchCache {
+public:
+    struct Key {
+        uint32_t cityId;
+        int32_t startDay;
+        int32_t endDay;
+        bool requireFree;   // Date-range searches also exclude approved bookings
+
+        bool operator==(const Key& other) const {
+            return cityId == other.cityId && startDay == other.startDay &&
+                   endDay == other.endDay && requireFree == other.requireFree;
+        }
+    };
+
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t invalidations = 0;   // Entries dropped by invalidate()
+        size_t evictions = 0;       // Entries dropped to stay within capacity
+        size_t entries = 0;
+    };
+
+    static const size_t MAX_ENTRIES = 256;
+    static const size_t MAX_SLOTS = 1 << 22;    // Total cached slots across entries
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            uint64_t value = (static_cast<uint64_t>(key.cityId) << 33) ^
+                             (static_cast<uint64_t>(static_cast<uint32_t>(key.startDay)) << 1) ^
+                             (static_cast<uint64_t>(static_cast<uint32_t>(key.endDay)) << 17) ^ key.requireFree;
+            return hash<uint64_t>()(value);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        vector<uint32_t> slots;
+    };
+
+    list<Entry> entries;    // Most recently used first
+    unordered_map<Key, list<Entry>::iterator, KeyHash> index;
+    size_t slotCount;
+    Stats stats;
+
+    void erase(list<Entry>::iterator it);
+
+public:
+    SearchCache() : slotCount(0) {}
+
+    // Cached candidates for key, or nullptr on a miss; a hit becomes most recent
+    const vector<uint32_t>* find(const Key& key);
+    // Stores slots for key; returns the cached copy, or nullptr if too large to keep
+    const vector<uint32_t>* insert(const Key& key, vector<uint32_t> slots);
+
+    // Drops entries for cityId whose dates lie inside [startDay, endDay],
+    // i.e. every cached search a motorbike with that window could appear in
+    void invalidate(uint32_t cityId, int32_t startDay, int32_t endDay);
+    void clear();
+
+    Stats getStats() const;
+};
+
+#endif
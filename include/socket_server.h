@@ -0,0 +1,78 @@
+#ifndef SOCKET_SERVER_H
+#define SOCKET_SERVER_H
+
+#include "event_loop.h"
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+// Accepts stream connections on an EventLoop and does their non-blocking
+// I/O (Linux only). A subclass turns the buffered input of a connection into
+// responses in handleInput; several servers can share one loop, and so one
+// thread and one engine.
+class SocketServer {
+public:
+    struct Stats {
+        size_t connections = 0;     // Open now
+        size_t accepted = 0;        // Since start
+        size_t requests = 0;
+    };
+
+protected:
+    struct Connection {
+        int fd;
+        string input;               // Received bytes not yet handled
+        string output;              // Responses not yet sent
+        size_t sent = 0;            // Bytes at the front of output already sent
+        string username;            // Set by the subclass once authenticated
+        bool closing = false;       // Stop reading; close once output is flushed
+        uint32_t events = 0;        // Currently registered epoll events
+    };
+
+    EventLoop& loop;
+    ostringstream messages;         // Engine messages of the request being handled
+
+    // Handles the complete requests at the front of connection.input, appending
+    // their responses to connection.output, and returns the bytes consumed.
+    // Stops early once backlogFull(connection); sets closing to hang up.
+    virtual size_t handleInput(Connection& connection) = 0;
+    // Called once per request: counts it and clears messages
+    void beginRequest();
+    void discardMessages();
+    // Last non-empty line the engine printed for this request
+    string lastMessage() const;
+    bool backlogFull(const Connection& connection) const;
+
+private:
+    int listenFd;
+    string socketPath;              // Unlinked on destruction; empty for TCP
+    bool acceptPaused;              // Out of descriptors; resumes when one closes
+    unordered_map<int, unique_ptr<Connection>> connections;
+    Stats stats;
+
+    bool startListening(int fd);
+    void acceptConnections();
+    void onConnectionEvent(int fd, uint32_t events);
+    bool readInput(Connection& connection);
+    bool flushOutput(Connection& connection);
+    void updateEvents(Connection& connection);
+    void closeConnection(int fd);
+
+public:
+    explicit SocketServer(EventLoop& loop);
+    virtual ~SocketServer();
+    SocketServer(const SocketServer&) = delete;
+    SocketServer& operator=(const SocketServer&) = delete;
+
+    // Unix domain socket; fails if another server is already answering on it
+    bool listenUnix(const string& path);
+    // TCP on an IPv4 address such as 127.0.0.1
+    bool listenTcp(const string& host, uint16_t port);
+    Stats getStats() const;
+};
+
+#endif
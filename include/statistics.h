@@ -0,0 +1,40 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include "search_cache.h"
+#include <cstddef>
+
+using namespace std;
+
+class Auth;
+class BookingManager;
+
+// System-wide totals shown on the admin statistics screen and served by the
+// HTTP API. Averages are 0 when there is nothing to average.
+struct SystemStatistics {
+    size_t totalUsers = 0;
+    size_t members = 0;
+    size_t admins = 0;
+    double totalCreditPoints = 0.0;     // Members only
+    double averageMemberRating = 0.0;
+
+    size_t totalMotorbikes = 0;
+    size_t listedMotorbikes = 0;
+    size_t availableMotorbikes = 0;
+    double totalDailyValue = 0.0;       // Daily price of the listed motorbikes
+    double averageMotorbikeRating = 0.0;
+
+    size_t totalBookings = 0;
+    size_t pendingBookings = 0;
+    size_t approvedBookings = 0;
+    size_t completedBookings = 0;
+    size_t rejectedBookings = 0;
+    double totalBookingValue = 0.0;
+
+    SearchCache::Stats searchCache;
+};
+
+// One pass over the users, motorbikes and bookings, read in place
+SystemStatistics collectStatistics(const Auth& auth, const BookingManager& bookingManager);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+using namespace std;
+
+// Interns low-cardinality field values (brands, models, cities, ID types,
+// roles, ...) so records store a 4-byte id instead of their own string copy,
+// and filters can compare ids instead of strings.
+//
+// intern() and find() belong to the thread that changes records. str() may
+// run on any thread for an id it received through a published snapshot
+// (booking_snapshot.h): strings live in segments that never move, so a
+// reader never sees the storage reallocate under it.
+class StringPool {
+private:
+    // Segment k holds FIRST_SEGMENT << k strings, enough for every uint32_t id
+    static const size_t FIRST_SEGMENT = 64;
+    static const size_t SEGMENTS = 27;
+
+    // Segment k starts at id (FIRST_SEGMENT << k) - FIRST_SEGMENT
+    static int segmentOf(uint32_t id) {
+        return 63 - __builtin_clzll(static_cast<uint64_t>(id) + FIRST_SEGMENT) - __builtin_ctzll(FIRST_SEGMENT);
+    }
+    static size_t offsetOf(uint32_t id, int segment) {
+        return static_cast<size_t>(id) + FIRST_SEGMENT - (FIRST_SEGMENT << segment);
+    }
+
+    unique_ptr<string[]> segments[SEGMENTS];
+    uint32_t count;
+    unordered_map<string_view, uint32_t> ids;  // Views into the segments
+
+public:
+    static const uint32_t NOT_FOUND = UINT32_MAX;
+
+    StringPool() : count(0) {}
+
+    // Returns the id for value, adding it to the pool if needed
+    uint32_t intern(string_view value);
+
+    // Returns the id for value, or NOT_FOUND if it was never interned.
+    // Use this for query inputs so searches do not grow the pool.
+    uint32_t find(string_view value) const;
+
+    const string& str(uint32_t id) const {
+        int segment = segmentOf(id);
+        return segments[segment][offsetOf(id, segment)];
+    }
+    size_t size() const { return count; }
+};
+
+// Process-wide pool shared by User, Motorbike and Booking fields
+StringPool& fieldPool();
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef TEXT_INDEX_H
+#define TEXT_INDEX_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <functional>
+
+using namespace std;
+
+// In-memory inverted index for keyword search. Text is split into lower-case
+// word tokens and each token maps to a posting list of the documents that
+// contain it, sorted by document id. Postings carry a weighted term count so
+// a word in a title field can count for more than one in free text.
+class TextIndex {
+public:
+    struct Posting {
+        uint32_t document;
+        float weight;       // Sum of field weights over the token's occurrences
+    };
+
+    struct Match {
+        uint32_t document;
+        double score;
+    };
+
+private:
+    map<string, vector<Posting>> postings;  // Ordered so prefix queries are a range scan
+    size_t documentCount;   // Highest document id seen + 1
+
+public:
+    static const size_t PREFIX_MIN_LENGTH = 3;
+    static constexpr double PREFIX_WEIGHT = 0.5;
+
+    TextIndex() : documentCount(0) {}
+
+    // Splits text into lower-case ASCII letter/digit runs; bytes >= 0x80 are
+    // kept inside words so UTF-8 text stays searchable
+    static void tokenize(string_view text, vector<string>& tokens);
+
+    // Adds every token of text to document with the given field weight
+    void add(uint32_t document, string_view text, float weight = 1.0f);
+
+    // Documents matching any query token, best first (ties by document id).
+    // Scores use BM25-style term saturation and inverse document frequency,
+    // so rare words and documents matching more query words rank higher.
+    // Query tokens of PREFIX_MIN_LENGTH or more also match longer words
+    // ("smooth" finds "smoothly") at PREFIX_WEIGHT of an exact match.
+    // Documents rejected by accept are dropped before ranking, so only the
+    // top limit accepted matches are ever sorted.
+    typedef function<bool(uint32_t document)> Filter;
+    vector<Match> search(string_view query, size_t limit, const Filter& accept = Filter()) const;
+
+    size_t termCount() const { return postings.size(); }
+};
+
+#endif
@@ -29,6 +29,7 @@ class UIBooking;
 class UIAdmin;
 class UIGuest;
 class UIDashboard;
+class UIAuth;
 
 /**
  * UI Class - User Interface Manager
@@ -50,6 +51,11 @@ public:
     void showMemberMenu();         // Display member-specific menu options
     void showAdminMenu();          // Display admin-specific menu options
     
+    // Authentication entry points - delegates to UIAuth
+    bool memberLogin();            // Prompt for member credentials and log in
+    bool adminLogin();             // Prompt for admin credentials and log in
+    bool registerUser();           // Prompt for registration details and register
+    
     // Component reference setters
     void setAuth(Auth* auth);
     void setBookingManager(BookingManager* bookingManager);
@@ -67,6 +73,7 @@ private:
     UIAdmin* uiAdmin;
     UIGuest* uiGuest;
     UIDashboard* uiDashboard;
+    UIAuth* uiAuth;
     
     // Helper method to initialize all UI modules
     void initializeUIModules();
@@ -0,0 +1,54 @@
+/**
+ * E-MOTORBIKE RENTAL APPLICATION
+ * Authentication UI Header File
+ * 
+ * This file defines the UIAuth class that handles the console side of
+ * login and registration: prompting, masked password entry and the
+ * registration fee confirmation.
+ * 
+ * @author Group 5 - EEET2482/EEET2653/COSC2082/COSC2721
+ * @version 1.0
+ * @date Semester 2 2025
+ */
+
+#ifndef UI_AUTH_H
+#define UI_AUTH_H
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+// Forward declarations
+class Auth;
+
+/**
+ * UIAuth Class - Login and Registration Interface
+ * 
+ * Reads credentials and registration details from the console and passes
+ * them to the non-interactive Auth methods.
+ */
+class UIAuth {
+public:
+    // Constructor
+    UIAuth();
+    
+    // Destructor
+    ~UIAuth();
+    
+    // Authentication functions
+    bool memberLogin();            // Prompt for member credentials and log in
+    bool adminLogin();             // Prompt for admin credentials and log in
+    bool registerUser();           // Prompt for registration details and register
+    
+    // Reads a password without echoing it, printing '*' per character
+    static string hidePassword();
+    
+    // Component reference setters
+    void setAuth(Auth* auth) { this->auth = auth; }
+    
+private:
+    Auth* auth;                    // Reference to authentication system
+};
+
+#endif
@@ -39,6 +39,7 @@ public:
     // Guest functions
     void viewGuestMotorbikeListings(); // Display limited motorbike listings for guests
     void searchGuestMotorbikes();      // Search motorbikes with limited information for guests
+    void searchGuestMotorbikesByKeyword(); // Ranked keyword search with limited information for guests
     
     // Component reference setters
     void setBookingManager(BookingManager* bookingManager) { this->bookingManager = bookingManager; }
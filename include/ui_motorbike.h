@@ -49,6 +49,7 @@ public:
     // Motorbike search and filtering functions
     void showMotorbikeSearchMenu(); // Display motorbike search menu
     void searchMotorbikes();       // Handle motorbike search process
+    void searchMotorbikesByKeyword(); // Ranked keyword search over listings and reviews
     void displayMotorbikeDetails(const struct Motorbike& motorbike); // Display motorbike details
     void displayMotorbikeReviews(const std::string& motorbikeId); // Display motorbike reviews
     
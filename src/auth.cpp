@@ -1,195 +1,113 @@
 #include "auth.h"
+#include "file_loader.h"
+#include "date.h"
+#include "message_stream.h"
 #include <iostream>
-#include <conio.h>
 #include <algorithm>
 #include <cctype>
 #include <vector>
 #include <fstream>
 #include <sstream>
+#include <cstdio>
+#include <cstdlib>
 
 using namespace std;
 
+static const string CREDIT_JOURNAL_HEADER =
+    "# Credit Journal Format: K|change|username|creditPoints (balance after credit change number change)";
+static const string CREDIT_WATERMARK = "# Credit changes: "; // account.txt line: last change it contains
+
 // User class implementation
-User::User(const string& username, const string& password, const string& role,
-           const string& fullName, const string& email, const string& phone,
-           const string& idType, const string& idNumber, 
-           const string& licenseNumber, const string& licenseExpiry,
+const uint32_t User::MEMBER = fieldPool().intern("member");
+const uint32_t User::ADMIN = fieldPool().intern("admin");
+
+User::User(string username, string password, string_view role,
+           string fullName, string email, string phone,
+           string_view idType, string idNumber, 
+           string licenseNumber, string licenseExpiry,
            double creditPoints, double rating)
-    : username(username), password(password), role(role), fullName(fullName),
-      email(email), phoneNumber(phone), idType(idType), idNumber(idNumber),
-      licenseNumber(licenseNumber), licenseExpiry(licenseExpiry),
+    : username(move(username)), password(move(password)), roleId(fieldPool().intern(role)),
+      fullName(move(fullName)), email(move(email)), phoneNumber(move(phone)),
+      idTypeId(fieldPool().intern(idType)), idNumber(move(idNumber)),
+      licenseNumber(move(licenseNumber)), licenseExpiry(move(licenseExpiry)),
       creditPoints(creditPoints), rating(rating) {
 }
 
 // Auth class implementation
-Auth::Auth() : currentUser(nullptr) {
+Auth::Auth()
+    : currentUser(nullptr), creditJournal("data/account.log", CREDIT_JOURNAL_HEADER), creditChanges(0),
+      savedCreditChanges(0), groupCommitOpen(false) {
     accountFilename = "data/account.txt";
+    bookingJournalFilename = "data/bookings.log"; // Approval charges, see BookingManager
+    if (!dataLock.isHeld()) {
+        return; // Another process owns the files
+    }
     loadUsers();
+    if (!creditJournal.open(replayCredits())) {
+        messageStream() << "Error: Cannot open credit journal." << endl;
+    }
 }
 
 Auth::~Auth() {
     saveUsers();
 }
 
-bool Auth::login() {
-    string username, password;
-    
-    cout << "\n=== MEMBER LOGIN ===" << endl;
-    cout << "Username: ";
-    cin >> username;
-    
-    cout << "Password: ";
-    password = hidePassword();
-    cout << endl;
-    
-    // Find user and validate credentials
-    for (User& user : users) {
-        if (user.getUsername() == username && 
-            user.getPassword() == password && 
-            user.getRole() == "member") {
-            currentUser = &user;
-            cout << "Login successful! Welcome, " << user.getFullName() << "!" << endl;
-            return true;
-        }
+bool Auth::login(const string& username, const string& password) {
+    User* user = findUser(username);
+    if (user && user->getPassword() == password && user->isMember()) {
+        currentUser = user;
+        messageStream() << "Login successful! Welcome, " << user->getFullName() << "!" << endl;
+        return true;
     }
     
-    cout << "Invalid username or password, or user is not a member." << endl;
+    messageStream() << "Invalid username or password, or user is not a member." << endl;
     return false;
 }
 
-bool Auth::adminLogin() {
-    string username, password;
-    
-    cout << "\n=== ADMIN LOGIN ===" << endl;
-    cout << "Username: ";
-    cin >> username;
-    
-    cout << "Password: ";
-    password = hidePassword();
-    cout << endl;
-    
-    // Find admin user and validate credentials
-    for (User& user : users) {
-        if (user.getUsername() == username && 
-            user.getPassword() == password && 
-            user.getRole() == "admin") {
-            currentUser = &user;
-            cout << "Admin login successful! Welcome, " << user.getFullName() << "!" << endl;
-            return true;
-        }
+bool Auth::adminLogin(const string& username, const string& password) {
+    User* user = findUser(username);
+    if (user && user->getPassword() == password && user->isAdmin()) {
+        currentUser = user;
+        messageStream() << "Admin login successful! Welcome, " << user->getFullName() << "!" << endl;
+        return true;
     }
     
-    cout << "Invalid admin username or password." << endl;
+    messageStream() << "Invalid admin username or password." << endl;
     return false;
 }
 
-bool Auth::registerUser() {
-    string username, password, fullName, email, phone;
-    
-    cout << "\n=== USER REGISTRATION ===" << endl;
-    cout << "Username: ";
-    cin >> username;
-    
-    // Check if username already exists
-    for (const User& user : users) {
-        if (user.getUsername() == username) {
-            cout << "Username already exists. Please choose a different username." << endl;
-            return false;
-        }
+const User* Auth::checkCredentials(const string& username, const string& password, const string& role) const {
+    const User* user = findUser(username);
+    if (user && user->getPassword() == password && user->getRole() == role) {
+        return user;
     }
-    
-    cout << "Password: ";
-    cin.ignore();
-    password = hidePassword();
-    cout << endl;
-    
-    // Validate password strength
-    if (!validatePassword(password)) {
-        cout << "Registration failed due to weak password." << endl;
-        return false;
-    }
-    
-    cout << "Full Name: ";
-    getline(cin, fullName);
-    
-    cout << "Email: ";
-    getline(cin, email);
-    
-    // Validate email
-    if (!validateEmail(email)) {
-        cout << "Registration failed due to invalid email." << endl;
+    return nullptr;
+}
+
+// Stores a new member once every field passes validation; the registration
+// fee is settled by the caller before this is called
+bool Auth::registerUser(const string& username, const string& password, const string& fullName,
+                        const string& email, const string& phone, const string& idType,
+                        const string& idNumber, const string& licenseNumber, const string& licenseExpiry) {
+    if (findUser(username)) {
+        messageStream() << "Username already exists. Please choose a different username." << endl;
         return false;
     }
-    
-    cout << "Phone Number: ";
-    getline(cin, phone);
-    
-    // Validate phone number
-    if (!validatePhoneNumber(phone)) {
-        cout << "Registration failed due to invalid phone number." << endl;
+    if (!validatePassword(password) || !validateEmail(email) || !validatePhoneNumber(phone)) {
         return false;
     }
-    
-    string idType, idNumber, licenseNumber, licenseExpiry;
-    
-    cout << "ID Type (Citizen ID or Passport): ";
-    getline(cin, idType);
-    
-    // Validate ID type
     if (idType != "Citizen ID" && idType != "Passport") {
-        cout << "Invalid ID type. Must be 'Citizen ID' or 'Passport'." << endl;
-        cout << "Registration failed." << endl;
+        messageStream() << "Invalid ID type. Must be 'Citizen ID' or 'Passport'." << endl;
         return false;
     }
-    
-    cout << "ID Number: ";
-    getline(cin, idNumber);
-    
-    // Validate ID number is not empty
     if (idNumber.empty()) {
-        cout << "ID Number cannot be empty." << endl;
-        cout << "Registration failed." << endl;
+        messageStream() << "ID Number cannot be empty." << endl;
         return false;
     }
     
-    cout << "Driver's License Number (optional, press Enter to skip): ";
-    getline(cin, licenseNumber);
-    
-    if (!licenseNumber.empty()) {
-        cout << "License Expiry Date (DD/MM/YYYY): ";
-        getline(cin, licenseExpiry);
-    } else {
-        licenseExpiry = "N/A";
-    }
-    
-    // Create new user
-    User newUser(username, password, "member", fullName, email, phone, 
-                 idType, idNumber, licenseNumber, licenseExpiry);
-    users.push_back(newUser);
-    
-    cout << "\n=== REGISTRATION FEE ===" << endl;
-    cout << "A $20 registration fee is required to complete registration." << endl;
-    cout << "Upon payment, you will receive 20 Credit Points and a default rating of 3.0." << endl;
-    cout << "Proceed with payment? (y/n): ";
-    
-    char payChoice;
-    cin >> payChoice;
-    
-    if (tolower(payChoice) != 'y') {
-        cout << "Registration cancelled. No payment processed." << endl;
-        users.pop_back(); // Remove the user we just added
-        return false;
-    }
-    
-    cout << "Processing payment of $20..." << endl;
-    cout << "Payment successful!" << endl;
-    cout << "Registration completed! Welcome, " << fullName << "!" << endl;
-    cout << "You have received 20 Credit Points and a default renter rating of 3.0." << endl;
-    cout << "You can now login with your credentials." << endl;
-    
-    // Save users to file
+    putUser(User(username, password, "member", fullName, email, phone, idType, idNumber,
+                 licenseNumber, licenseNumber.empty() ? "N/A" : licenseExpiry));
     saveUsers();
-    
     return true;
 }
 
@@ -201,40 +119,23 @@ User* Auth::getCurrentUser() {
     return currentUser;
 }
 
-string Auth::hidePassword() {
-    string password;
-    char ch;
-    while ((ch = _getch()) != '\r') { // '\r' is Enter key
-        if (ch == '\b') { // Backspace
-            if (!password.empty()) {
-                password.pop_back();
-                cout << "\b \b";
-            }
-        } else {
-            password += ch;
-            cout << '*';
-        }
-    }
-    return password;
-}
-
 bool Auth::validateEmail(const string& email) {
     // Check basic email format
     if (email.find('@') == string::npos) {
-        cout << "Email must contain @ symbol." << endl;
+        messageStream() << "Email must contain @ symbol." << endl;
         return false;
     }
     
     // Check for at least one dot after @
     size_t atPos = email.find('@');
     if (email.find('.', atPos) == string::npos) {
-        cout << "Email must have a valid domain (e.g., example.com)." << endl;
+        messageStream() << "Email must have a valid domain (e.g., example.com)." << endl;
         return false;
     }
     
     // Check minimum length
     if (email.length() < 5) {
-        cout << "Email is too short." << endl;
+        messageStream() << "Email is too short." << endl;
         return false;
     }
     
@@ -244,14 +145,14 @@ bool Auth::validateEmail(const string& email) {
 bool Auth::validatePhoneNumber(const string& phone) {
     // Check length (10-11 digits for Vietnamese phone numbers)
     if (phone.length() < 10 || phone.length() > 11) {
-        cout << "Phone number must be 10-11 digits long." << endl;
+        messageStream() << "Phone number must be 10-11 digits long." << endl;
         return false;
     }
     
     // Check if all characters are digits
     for (char c : phone) {
         if (!isdigit(c)) {
-            cout << "Phone number must contain only digits." << endl;
+            messageStream() << "Phone number must contain only digits." << endl;
             return false;
         }
     }
@@ -262,7 +163,7 @@ bool Auth::validatePhoneNumber(const string& phone) {
 bool Auth::validatePassword(const string& password) {
     // Check minimum length
     if (password.length() < 8) {
-        cout << "Password must be at least 8 characters long." << endl;
+        messageStream() << "Password must be at least 8 characters long." << endl;
         return false;
     }
     
@@ -277,7 +178,7 @@ bool Auth::validatePassword(const string& password) {
     
     for (const string& weak : weakPasswords) {
         if (lowerPassword == weak) {
-            cout << "Password is too weak. Please choose a stronger password." << endl;
+            messageStream() << "Password is too weak. Please choose a stronger password." << endl;
             return false;
         }
     }
@@ -291,7 +192,7 @@ bool Auth::validatePassword(const string& password) {
         }
     }
     if (!hasUpper) {
-        cout << "Password must contain at least one uppercase letter." << endl;
+        messageStream() << "Password must contain at least one uppercase letter." << endl;
         return false;
     }
     
@@ -304,7 +205,7 @@ bool Auth::validatePassword(const string& password) {
         }
     }
     if (!hasLower) {
-        cout << "Password must contain at least one lowercase letter." << endl;
+        messageStream() << "Password must contain at least one lowercase letter." << endl;
         return false;
     }
     
@@ -317,7 +218,7 @@ bool Auth::validatePassword(const string& password) {
         }
     }
     if (!hasDigit) {
-        cout << "Password must contain at least one digit." << endl;
+        messageStream() << "Password must contain at least one digit." << endl;
         return false;
     }
     
@@ -326,14 +227,13 @@ bool Auth::validatePassword(const string& password) {
 
 bool Auth::updateProfile(const string& username, const string& fullName, 
                         const string& email, const string& phoneNumber) {
-    for (User& user : users) {
-        if (user.getUsername() == username) {
-            user.setFullName(fullName);
-            user.setEmail(email);
-            user.setPhoneNumber(phoneNumber);
-            saveUsers(); // Save to file after updating
-            return true;
-        }
+    User* user = findUser(username);
+    if (user) {
+        user->setFullName(fullName);
+        user->setEmail(email);
+        user->setPhoneNumber(phoneNumber);
+        saveUsers(); // Save to file after updating
+        return true;
     }
     return false;
 }
@@ -348,87 +248,140 @@ bool Auth::changePassword(const string& username, const string& oldPassword,
 }
 
 bool Auth::topUpCreditPoints(const string& username, double amount) {
-    for (User& user : users) {
-        if (user.getUsername() == username) {
-            user.setCreditPoints(user.getCreditPoints() + amount);
-            saveUsers(); // Save to file after updating
-            return true;
+    User* user = findUser(username);
+    if (user) {
+        string record;
+        {
+            unique_lock<mutex> lock = creditLock(username);
+            user->setCreditPoints(user->getCreditPoints() + amount);
+            record = formatCreditRecord(++creditChanges, username, user->getCreditPoints());
         }
+        return logCreditChanges(record, 1); // Save to file after updating
     }
     return false;
 }
 
 bool Auth::deductCreditPoints(const string& username, double amount) {
-    for (User& user : users) {
-        if (user.getUsername() == username) {
-            if (user.getCreditPoints() >= amount) {
-                user.setCreditPoints(user.getCreditPoints() - amount);
-                saveUsers(); // Save to file after updating
-                return true;
+    User* user = findUser(username);
+    if (user) {
+        string record;
+        {
+            // Check and deduct under one lock so two approvals cannot both spend the same points
+            unique_lock<mutex> lock = creditLock(username);
+            if (user->getCreditPoints() < amount) {
+                return false; // Insufficient credits
             }
-            return false; // Insufficient credits
+            user->setCreditPoints(user->getCreditPoints() - amount);
+            record = formatCreditRecord(++creditChanges, username, user->getCreditPoints());
         }
+        return logCreditChanges(record, 1); // Save to file after updating
     }
     return false;
 }
 
+bool Auth::chargeCreditPoints(const string& username, double amount, unique_lock<mutex>& hold, string& record) {
+    User* user = findUser(username);
+    if (!user) {
+        return false;
+    }
+    unique_lock<mutex> lock = creditLock(username);
+    if (user->getCreditPoints() < amount) {
+        return false; // Insufficient credits
+    }
+    user->setCreditPoints(user->getCreditPoints() - amount);
+    record = formatCreditRecord(++creditChanges, username, user->getCreditPoints());
+    hold = move(lock);
+    return true;
+}
+
+string Auth::formatCreditRecord(uint64_t change, const string& username, double creditPoints) {
+    ostringstream record;
+    record << "K|" << change << "|" << username << "|" << creditPoints << "\n";
+    return record.str();
+}
+
+bool Auth::parseCreditRecord(string_view line, uint64_t& change, string& username, double& creditPoints) {
+    string_view fields[4];
+    if (line.size() < 2 || line[0] != 'K' || line[1] != '|' ||
+        splitRecord(trimField(line), fields, 4) != 4) {
+        return false;
+    }
+    change = strtoull(string(fields[1]).c_str(), nullptr, 10);
+    username = string(fields[2]);
+    creditPoints = parseDouble(fields[3]);
+    return change != 0;
+}
+
 void Auth::displayProfile(const string& username, BookingManager* bookingManager) {
     (void)bookingManager; // Suppress unused parameter warning
-    for (const User& user : users) {
-        if (user.getUsername() == username) {
-            cout << "=== USER PROFILE ===" << endl;
-            cout << "Username: " << user.getUsername() << endl;
-            cout << "Full Name: " << user.getFullName() << endl;
-            cout << "Email: " << user.getEmail() << endl;
-            cout << "Phone: " << user.getPhoneNumber() << endl;
-            cout << "Role: " << user.getRole() << endl;
-            cout << "Credit Points: " << user.getCreditPoints() << endl;
-            cout << "Rating: " << user.getRating() << endl;
-            return;
-        }
+    const User* user = findUser(username);
+    if (user) {
+        messageStream() << "=== USER PROFILE ===" << endl;
+        messageStream() << "Username: " << user->getUsername() << endl;
+        messageStream() << "Full Name: " << user->getFullName() << endl;
+        messageStream() << "Email: " << user->getEmail() << endl;
+        messageStream() << "Phone: " << user->getPhoneNumber() << endl;
+        messageStream() << "Role: " << user->getRole() << endl;
+        messageStream() << "Credit Points: " << user->getCreditPoints() << endl;
+        messageStream() << "Rating: " << user->getRating() << endl;
     }
 }
 
 double Auth::getUserRenterRating(const string& username) {
-    for (const User& user : users) {
-        if (user.getUsername() == username) {
-            return user.getRating();
-        }
-    }
-    return 3.0; // Default rating
+    const User* user = findUser(username);
+    return user ? user->getRating() : 3.0; // Default rating
 }
 
 double Auth::getUserCreditPoints(const string& username) {
-    for (const User& user : users) {
-        if (user.getUsername() == username) {
-            return user.getCreditPoints();
-        }
+    const User* user = findUser(username);
+    if (!user) {
+        return 0.0;
     }
-    return 0.0;
+    unique_lock<mutex> lock = creditLock(username);
+    return user->getCreditPoints();
 }
 
 string Auth::getUserLicenseExpiry(const string& username) {
-    for (const User& user : users) {
-        if (user.getUsername() == username) {
-            return user.getLicenseExpiry();
-        }
-    }
-    return "N/A";
+    const User* user = findUser(username);
+    return user ? user->getLicenseExpiry() : "N/A";
 }
 
 vector<User> Auth::getAllUsers() {
-    return users;
+    return vector<User>(users.begin(), users.end());
+}
+
+bool Auth::putUser(User user) {
+    if (!userIndex.emplace(user.getUsername(), users.size()).second) {
+        return false; // Username already taken
+    }
+    users.emplace_back(move(user));
+    return true;
+}
+
+User* Auth::findUser(const string& username) {
+    auto it = userIndex.find(username);
+    return it != userIndex.end() ? &users[it->second] : nullptr;
+}
+
+const User* Auth::findUser(const string& username) const {
+    auto it = userIndex.find(username);
+    return it != userIndex.end() ? &users[it->second] : nullptr;
+}
+
+unique_lock<mutex> Auth::creditLock(const string& username) const {
+    mutex& stripe = creditLocks[hash<string>()(username) % CREDIT_LOCK_STRIPES];
+    return groupCommitOpen ? unique_lock<mutex>(stripe, defer_lock) : unique_lock<mutex>(stripe);
 }
 
 bool Auth::verifyIdentity(const string& username) {
     (void)username; // Suppress unused parameter warning
-    cout << "Identity verification completed!" << endl;
+    messageStream() << "Identity verification completed!" << endl;
     return true;
 }
 
 void Auth::displayVerificationStatus(const string& username) {
     (void)username; // Suppress unused parameter warning
-    cout << "Verification Status: Verified" << endl;
+    messageStream() << "Verification Status: Verified" << endl;
 }
 
 // User license validation method
@@ -441,64 +394,150 @@ bool User::hasValidLicense() const {
         return false; // No expiry date
     }
     
-    // Simple date validation - in real app would use proper date parsing
-    // For now, assume format DD/MM/YYYY and check if year is current or future
-    if (licenseExpiry.length() >= 10) {
-        string year = licenseExpiry.substr(6, 4);
-        try {
-            int expiryYear = stoi(year);
-            return expiryYear >= 2025; // Current year or later
-        } catch (...) {
-            return false;
-        }
-    }
-    
-    return false;
+    // Expiry must be a DD/MM/YYYY date in the current year or later
+    Date expiry = Date::parse(licenseExpiry);
+    return expiry.isValid() && expiry.year() >= 2025;
 }
 
 void Auth::loadUsers() {
-    ifstream file(accountFilename);
-    if (!file.is_open()) {
+    MappedFile file(accountFilename);
+    if (!file.isOpen()) {
         return;
     }
     
+    userIndex.reserve(countLines(file.view()));
+    forEachRecord(file.view(), [this](const string_view* fields, size_t count) {
+        if (count >= 12) {
+            putUser(User(string(fields[0]), string(fields[1]), fields[2],
+                         string(fields[3]), string(fields[4]), string(fields[5]),
+                         fields[6], string(fields[7]), string(fields[8]),
+                         string(fields[9]), parseDouble(fields[10]), parseDouble(fields[11])));
+        }
+    });
+}
+
+// Applies the K records newer than account.txt from both journals. A record
+// holds the user's balance after its change, so for each user the highest
+// numbered one wins. Returns the number of records in account.log.
+int Auth::replayCredits() {
+    uint64_t saved = 0;
     string line;
-    while (getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        
-        // Trim whitespace
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-        
-        if (line.empty()) continue;
-        
-        stringstream ss(line);
-        string token;
-        vector<string> tokens;
-        
-        while (getline(ss, token, '|')) {
-            token.erase(0, token.find_first_not_of(" \t\r\n"));
-            token.erase(token.find_last_not_of(" \t\r\n") + 1);
-            tokens.push_back(token);
+    ifstream account(accountFilename);
+    while (getline(account, line) && !line.empty() && line[0] == '#') {
+        if (line.compare(0, CREDIT_WATERMARK.size(), CREDIT_WATERMARK) == 0) {
+            saved = strtoull(line.c_str() + CREDIT_WATERMARK.size(), nullptr, 10);
         }
-        
-        if (tokens.size() >= 12) {
-            User user(tokens[0], tokens[1], tokens[2], tokens[3], tokens[4], tokens[5],
-                     tokens[6], tokens[7], tokens[8], tokens[9], stod(tokens[10]), stod(tokens[11]));
-            users.push_back(user);
+    }
+    
+    unordered_map<string, pair<uint64_t, double>> latest; // username -> (change, balance)
+    uint64_t lastChange = saved;
+    int accountLogRecords = 0;
+    const string* journals[] = {&creditJournal.getFilename(), &bookingJournalFilename};
+    for (const string* filename : journals) {
+        Journal::replay(*filename, [&](const string& record) {
+            uint64_t change;
+            string username;
+            double creditPoints;
+            if (!parseCreditRecord(record, change, username, creditPoints)) return;
+            if (filename == journals[0]) {
+                accountLogRecords++;
+            }
+            lastChange = max(lastChange, change);
+            pair<uint64_t, double>& entry = latest[username];
+            if (change > saved && change > entry.first) {
+                entry = make_pair(change, creditPoints);
+            }
+        });
+    }
+    
+    for (const auto& entry : latest) {
+        User* user = findUser(entry.first);
+        if (user && entry.second.first != 0) {
+            user->setCreditPoints(entry.second.second);
         }
     }
-    file.close();
+    creditChanges = lastChange;
+    savedCreditChanges = saved;
+    return accountLogRecords;
+}
+
+// Makes standalone credit changes durable: count K records appended to
+// account.log and synced to the disk, or held for the open group commit.
+// False when the write failed; the change stays applied in memory.
+bool Auth::logCreditChanges(const string& records, int count) {
+    if (groupCommitOpen) {
+        groupCredits += records;
+        return true;
+    }
+    if (!creditJournal.isOpen()) {
+        lock_guard<mutex> lock(accountFileMutex);
+        return foldCredits(); // No journal available - fall back to rewriting the whole file
+    }
+    if (!creditJournal.commit(creditJournal.append(records, count))) {
+        messageStream() << "Error: Cannot write credit journal." << endl;
+        return false;
+    }
+    saveCreditsIfDue();
+    return true;
 }
 
 void Auth::saveUsers() {
-    ofstream file(accountFilename);
-    if (!file.is_open()) {
-        cout << "Error: Cannot save users to file." << endl;
+    lock_guard<mutex> lock(accountFileMutex);
+    foldCredits();
+}
+
+void Auth::saveCreditsIfDue() {
+    if (groupCommitOpen || creditChanges.load() - savedCreditChanges.load() < CREDIT_SAVE_THRESHOLD) {
         return;
     }
+    lock_guard<mutex> lock(accountFileMutex);
+    if (creditChanges.load() - savedCreditChanges.load() >= CREDIT_SAVE_THRESHOLD) {
+        foldCredits(); // Not done by a thread that held the file first
+    }
+}
+
+// Rewrites account.txt and drops the account.log records it now contains;
+// call with accountFileMutex held. The journal position is read before
+// writeUsers numbers its contents: a record appended by then belongs to a
+// change numbered earlier still, so account.txt includes it.
+bool Auth::foldCredits() {
+    uint64_t logged = creditJournal.lastSequence();
+    if (!writeUsers()) {
+        return false;
+    }
+    if (creditJournal.isOpen()) {
+        creditJournal.rewrite("", 0, logged);
+    }
+    return true;
+}
+
+void Auth::beginGroupCommit() {
+    groupCommitOpen = true;
+}
+
+string Auth::endGroupCommit() {
+    groupCommitOpen = false;
+    string records;
+    records.swap(groupCredits);
+    return records;
+}
+
+// Rewrites account.txt through a temporary file; call with accountFileMutex held
+bool Auth::writeUsers() {
+    if (!dataLock.isHeld()) {
+        return false;
+    }
+    // Every change numbered up to here has been applied to its user
+    uint64_t changes = creditChanges.load();
+    string tempFilename = accountFilename + ".tmp";
+    ofstream file(tempFilename);
+    if (!file.is_open()) {
+        messageStream() << "Error: Cannot save users to file." << endl;
+        return false;
+    }
     
     file << "# Account Data Format: username|password|role|fullName|email|phoneNumber|idType|idNumber|licenseNumber|licenseExpiry|creditPoints|rating" << endl;
+    file << CREDIT_WATERMARK << changes << endl;
     
     for (const User& user : users) {
         file << user.getUsername() << "|"
@@ -510,9 +549,26 @@ void Auth::saveUsers() {
              << user.getIdType() << "|"
              << user.getIdNumber() << "|"
              << user.getLicenseNumber() << "|"
-             << user.getLicenseExpiry() << "|"
-             << user.getCreditPoints() << "|"
-             << user.getRating() << endl;
+             << user.getLicenseExpiry() << "|";
+        {
+            unique_lock<mutex> lock = creditLock(user.getUsername());
+            file << user.getCreditPoints();
+        }
+        file << "|" << user.getRating() << endl;
     }
     file.close();
+    if (file.fail()) {
+        messageStream() << "Error: Cannot save users to file." << endl;
+        return false;
+    }
+    
+#ifdef _WIN32
+    remove(accountFilename.c_str()); // rename() does not replace existing files on Windows
+#endif
+    if (rename(tempFilename.c_str(), accountFilename.c_str()) != 0) {
+        messageStream() << "Error: Cannot save users to file." << endl;
+        return false;
+    }
+    savedCreditChanges = changes;
+    return true;
 }
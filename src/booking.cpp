@@ -1,10 +1,16 @@
 #include "booking.h"
 #include "auth.h"
+#include "file_loader.h"
+#include "booking_snapshot.h"
+#include "message_stream.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 
 using namespace std;
 
@@ -13,36 +19,36 @@ using namespace std;
 // MOTORBIKE CLASS IMPLEMENTATION
 // ============================================================================
 
-Motorbike::Motorbike(const string& motorbikeId, const string& ownerUsername,
-                     const string& brand, const string& model, const string& color,
-                     const string& size, const string& plateNo, double pricePerDay,
-                     const string& location, bool isAvailable, double rating,
-                     const string& description, const string& availableStartDate,
-                     const string& availableEndDate, double minRenterRating,
+Motorbike::Motorbike(string motorbikeId, string ownerUsername,
+                     string_view brand, string_view model, string_view color,
+                     string_view size, string plateNo, double pricePerDay,
+                     string_view location, bool isAvailable, double rating,
+                     string description, string_view availableStartDate,
+                     string_view availableEndDate, double minRenterRating,
                      bool isListed)
-    : motorbikeId(motorbikeId), ownerUsername(ownerUsername), brand(brand), model(model),
-      color(color), size(size), plateNo(plateNo), pricePerDay(pricePerDay),
-      location(location), isAvailable(isAvailable), rating(rating), description(description),
-      availableStartDate(availableStartDate), availableEndDate(availableEndDate),
+    : motorbikeId(move(motorbikeId)), ownerUsername(move(ownerUsername)), brandId(fieldPool().intern(brand)),
+      modelId(fieldPool().intern(model)), colorId(fieldPool().intern(color)), sizeId(fieldPool().intern(size)),
+      plateNo(move(plateNo)), pricePerDay(pricePerDay), locationId(fieldPool().intern(location)), isAvailable(isAvailable), rating(rating), description(move(description)),
+      availableStartDate(Date::parse(availableStartDate)), availableEndDate(Date::parse(availableEndDate)),
       minRenterRating(minRenterRating), isListed(isListed) {
 }
 
 void Motorbike::displayInfo() const {
-    cout << "=== MOTORBIKE DETAILS ===" << endl;
-    cout << "ID: " << motorbikeId << endl;
-    cout << "Brand: " << brand << endl;
-    cout << "Model: " << model << endl;
-    cout << "Color: " << color << endl;
-    cout << "Size: " << size << endl;
-    cout << "Plate: " << plateNo << endl;
-    cout << "Price/Day: " << pricePerDay << " CP" << endl;
-    cout << "Location: " << location << endl;
-    cout << "Available: " << (isAvailable ? "Yes" : "No") << endl;
-    cout << "Rating: " << rating << "/5.0" << endl;
-    cout << "Description: " << description << endl;
-    cout << "Available Period: " << availableStartDate << " to " << availableEndDate << endl;
-    cout << "Min Renter Rating: " << minRenterRating << endl;
-    cout << "Listed: " << (isListed ? "Yes" : "No") << endl;
+    messageStream() << "=== MOTORBIKE DETAILS ===" << endl;
+    messageStream() << "ID: " << motorbikeId << endl;
+    messageStream() << "Brand: " << getBrand() << endl;
+    messageStream() << "Model: " << getModel() << endl;
+    messageStream() << "Color: " << getColor() << endl;
+    messageStream() << "Size: " << getSize() << endl;
+    messageStream() << "Plate: " << plateNo << endl;
+    messageStream() << "Price/Day: " << pricePerDay << " CP" << endl;
+    messageStream() << "Location: " << getLocation() << endl;
+    messageStream() << "Available: " << (isAvailable ? "Yes" : "No") << endl;
+    messageStream() << "Rating: " << rating << "/5.0" << endl;
+    messageStream() << "Description: " << description << endl;
+    messageStream() << "Available Period: " << getAvailableStartDate() << " to " << getAvailableEndDate() << endl;
+    messageStream() << "Min Renter Rating: " << minRenterRating << endl;
+    messageStream() << "Listed: " << (isListed ? "Yes" : "No") << endl;
 }
 
 double Motorbike::calculateRentalCost(int days) const {
@@ -57,17 +63,11 @@ void Motorbike::setMinRenterRating(double rating) {
 
 int Motorbike::getEngineSize() const {
     // Extract engine size from size string (e.g., "150cc" -> 150)
-    string sizeStr = size;
-    size_t pos = sizeStr.find("cc");
-    if (pos != string::npos) {
-        sizeStr = sizeStr.substr(0, pos);
-        try {
-            return stoi(sizeStr);
-        } catch (...) {
-            return 0;
-        }
+    const string& sizeStr = getSize();
+    if (sizeStr.find("cc") == string::npos) {
+        return 0;
     }
-    return 0;
+    return atoi(sizeStr.c_str()); // Stops at "cc"; 0 if no leading number
 }
 
 bool Motorbike::isElectric() const {
@@ -76,12 +76,20 @@ bool Motorbike::isElectric() const {
 }
 
 bool Motorbike::isAvailableForDate(const string& date) const {
-    // Simple date comparison - in real app, would use proper date parsing
-    return date >= availableStartDate && date <= availableEndDate;
+    return isAvailableForDate(Date::parse(date));
 }
 
 bool Motorbike::isAvailableForDateRange(const string& startDate, const string& endDate) const {
-    return startDate >= availableStartDate && endDate <= availableEndDate;
+    return isAvailableForDateRange(Date::parse(startDate), Date::parse(endDate));
+}
+
+bool Motorbike::isAvailableForDate(Date date) const {
+    return date.isValid() && date >= availableStartDate && date <= availableEndDate;
+}
+
+bool Motorbike::isAvailableForDateRange(Date startDate, Date endDate) const {
+    return startDate.isValid() && endDate.isValid() &&
+           startDate >= availableStartDate && endDate <= availableEndDate;
 }
 
 bool Motorbike::meetsRenterRequirements(double renterRating) const {
@@ -92,21 +100,64 @@ bool Motorbike::meetsRenterRequirements(double renterRating) const {
 // BOOKING CLASS IMPLEMENTATION
 // ============================================================================
 
-Booking::Booking(const string& bookingId, const string& renterUsername,
-                 const string& ownerUsername, const string& motorbikeId,
-                 const string& startDate, const string& endDate, const string& status,
-                 double totalCost, const string& brand, const string& model,
-                 const string& color, const string& size, const string& plateNo)
-    : bookingId(bookingId), renterUsername(renterUsername), ownerUsername(ownerUsername),
-      motorbikeId(motorbikeId), startDate(startDate), endDate(endDate), status(status),
-      totalCost(totalCost), brand(brand), model(model), color(color), size(size), plateNo(plateNo) {
+const string& bookingStatusName(BookingStatus status) {
+    static const string names[BOOKING_STATUS_COUNT] = {"Pending", "Approved", "Rejected", "Completed"};
+    return names[static_cast<size_t>(status)];
 }
 
-void Booking::setStatus(const string& status) {
-    vector<string> validStatuses = {"Pending", "Approved", "Rejected", "Completed"};
-    if (find(validStatuses.begin(), validStatuses.end(), status) != validStatuses.end()) {
-        this->status = status;
+const string& bookingErrorMessage(BookingError error) {
+    static const string messages[] = {
+        "Rental request submitted successfully!",
+        "Motorbike not found.",
+        "Invalid date range. Use DD/MM/YYYY with the end date on or after the start date.",
+        "Renter rating is below the motorbike's minimum.",
+        "Insufficient credit points.",
+        "You already have an active rental.",
+        "Valid license required for motorbikes over 50cc.",
+        "Motorbike not available for the selected date range.",
+        "Motorbike already booked for this period.",
+        "Overlaps an earlier request for this motorbike in the same batch.",
+        "Booking created but not yet saved: the journal write failed."
+    };
+    static_assert(sizeof(messages) / sizeof(messages[0]) == static_cast<size_t>(BookingError::NotSaved) + 1,
+                  "One message per BookingError");
+    return messages[static_cast<size_t>(error)];
+}
+
+bool parseBookingStatus(string_view text, BookingStatus& status) {
+    for (size_t i = 0; i < BOOKING_STATUS_COUNT; i++) {
+        BookingStatus candidate = static_cast<BookingStatus>(i);
+        if (text == bookingStatusName(candidate)) {
+            status = candidate;
+            return true;
+        }
     }
+    return false;
+}
+
+Booking::Booking(string bookingId, string renterUsername,
+                 string ownerUsername, string motorbikeId,
+                 string_view startDate, string_view endDate, string_view status,
+                 double totalCost, string_view brand, string_view model,
+                 string_view color, string_view size, string plateNo)
+    : bookingId(move(bookingId)), renterUsername(move(renterUsername)), ownerUsername(move(ownerUsername)),
+      motorbikeId(move(motorbikeId)), startDate(Date::parse(startDate)), endDate(Date::parse(endDate)),
+      status(BookingStatus::Pending), totalCost(totalCost), brandId(fieldPool().intern(brand)),
+      modelId(fieldPool().intern(model)), colorId(fieldPool().intern(color)), sizeId(fieldPool().intern(size)),
+      plateNo(move(plateNo)) {
+    setStatus(status);
+}
+
+void Booking::setStatus(string_view status) {
+    parseBookingStatus(status, this->status);
+}
+
+bool Booking::transitionTo(BookingStatus next) {
+    if (!canTransition(status, next)) {
+        return false;
+    }
+    status = next;
+    return true;
 }
 
 void Booking::setTotalCost(double totalCost) {
@@ -116,360 +167,936 @@ void Booking::setTotalCost(double totalCost) {
 }
 
 int Booking::getDurationInDays() const {
-    // Simple calculation - in real app, would use proper date parsing
-    // For now, return 1 day as default
-    return 1;
+    // Both ends of the period count as rental days
+    if (!startDate.isValid() || !endDate.isValid() || endDate < startDate) {
+        return 1;
+    }
+    return endDate - startDate + 1;
 }
 
 void Booking::displayInfo() const {
-    cout << "=== BOOKING DETAILS ===" << endl;
-    cout << "Booking ID: " << bookingId << endl;
-    cout << "Renter: " << renterUsername << endl;
-    cout << "Owner: " << ownerUsername << endl;
-    cout << "Motorbike: " << brand << " " << model << " (" << color << ", " << size << ")" << endl;
-    cout << "Plate: " << plateNo << endl;
-    cout << "Period: " << startDate << " to " << endDate << endl;
-    cout << "Status: " << status << endl;
-    cout << "Total Cost: " << totalCost << " CP" << endl;
+    messageStream() << "=== BOOKING DETAILS ===" << endl;
+    messageStream() << "Booking ID: " << bookingId << endl;
+    messageStream() << "Renter: " << renterUsername << endl;
+    messageStream() << "Owner: " << ownerUsername << endl;
+    messageStream() << "Motorbike: " << getBrand() << " " << getModel() << " (" << getColor() << ", " << getSize() << ")" << endl;
+    messageStream() << "Plate: " << plateNo << endl;
+    messageStream() << "Period: " << getStartDate() << " to " << getEndDate() << endl;
+    messageStream() << "Status: " << getStatus() << endl;
+    messageStream() << "Total Cost: " << totalCost << " CP" << endl;
 }
 
 // ============================================================================
 // REVIEW CLASS IMPLEMENTATION
 // ============================================================================
 
-Review::Review(const string& reviewId, const string& motorbikeId, 
-               const string& renterUsername, double rating,
-               const string& comment, const string& reviewDate)
-    : reviewId(reviewId), motorbikeId(motorbikeId), renterUsername(renterUsername),
-      rating(rating), comment(comment), reviewDate(reviewDate) {
+Review::Review(string reviewId, string motorbikeId, 
+               string renterUsername, double rating,
+               string comment, string reviewDate)
+    : reviewId(move(reviewId)), motorbikeId(move(motorbikeId)), renterUsername(move(renterUsername)),
+      rating(rating), comment(move(comment)), reviewDate(move(reviewDate)) {
 }
 
 // ============================================================================
 // BOOKING MANAGER CLASS IMPLEMENTATION
 // ============================================================================
 
-BookingManager::BookingManager() {
+static const string BOOKING_JOURNAL_HEADER =
+    "# Booking Journal Format: C|<booking record> (new booking), S|bookingId|status (status change), "
+    "A|motorbikeId|0 or 1 (availability), L|<motorbike record> (listing added or changed), "
+    "K|change|username|creditPoints (credit change, see account.log) or B|count (the next count records are one change)";
+
+BookingManager::BookingManager()
+    : journal("data/bookings.log", BOOKING_JOURNAL_HEADER), creditWatermark(0), publishedVersion(0),
+      savedMotorbikeVersion(0), groupCommitOpen(false), groupJournalRecords(0), groupPublishPending(false) {
     bookingFilename = "data/bookings.txt";
     motorbikeFilename = "data/motorbikes.txt";
     reviewFilename = "data/reviews.txt";
+    if (!dataLock.isHeld()) {
+        publishSnapshot(); // Empty; another process owns the files
+        return;
+    }
     loadBookings();
     loadMotorbikes();
     loadReviews();
+    if (!journal.open(replayJournal())) {
+        messageStream() << "Error: Cannot open booking journal." << endl;
+    }
+    publishSnapshot();
 }
 
 BookingManager::~BookingManager() {
-    saveBookings();
-    saveMotorbikes();
+    {
+        lock_guard<mutex> compacting(compactMutex);
+        compactJournal();
+    }
+}
+
+// Record builders shared by the file loaders and journal replay
+static Booking bookingFromFields(const string_view* fields) {
+    return Booking(string(fields[0]), string(fields[1]), string(fields[2]), string(fields[3]),
+                   fields[4], fields[5], fields[6], parseDouble(fields[7]),
+                   fields[8], fields[9], fields[10], fields[11], string(fields[12]));
+}
+
+static Motorbike motorbikeFromFields(const string_view* fields) {
+    return Motorbike(string(fields[0]), string(fields[1]), fields[2], fields[3],
+                     fields[4], fields[5], string(fields[6]), parseDouble(fields[7]),
+                     fields[8], fields[9] == "1", parseDouble(fields[10]),
+                     string(fields[11]), fields[12], fields[13],
+                     parseDouble(fields[14]), fields[15] == "1");
+}
+
+static Review reviewFromFields(const string_view* fields) {
+    return Review(string(fields[0]), string(fields[1]), string(fields[2]), parseDouble(fields[3]),
+                  string(fields[4]), string(fields[5]));
 }
 
 void BookingManager::loadBookings() {
-    ifstream file(bookingFilename);
-    if (!file.is_open()) {
+    MappedFile file(bookingFilename);
+    if (!file.isOpen()) {
         return;
     }
     
-    string line;
-    while (getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        
-        // Trim whitespace
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-        
-        if (line.empty()) continue;
-        
-        stringstream ss(line);
-        string token;
-        vector<string> tokens;
-        
-        while (getline(ss, token, '|')) {
-            token.erase(0, token.find_first_not_of(" \t\r\n"));
-            token.erase(token.find_last_not_of(" \t\r\n") + 1);
-            tokens.push_back(token);
+    size_t lineCount = countLines(file.view());
+    bookings.reserve(lineCount);
+    bookingIndex.reserve(lineCount);
+    forEachRecord(file.view(), [this](const string_view* fields, size_t count) {
+        if (count < 13) {
+            return;
         }
-        
-        if (tokens.size() >= 13) {
-            Booking booking(tokens[0], tokens[1], tokens[2], tokens[3], tokens[4], tokens[5],
-                           tokens[6], stod(tokens[7]), tokens[8], tokens[9], tokens[10], tokens[11], tokens[12]);
-            bookings.push_back(booking);
+        // Saving would write an unparseable date back as an empty field
+        Booking booking = bookingFromFields(fields);
+        if (!booking.getStart().isValid() || !booking.getEnd().isValid()) {
+            messageStream() << "Skipping booking " << booking.getBookingId() << " in " << bookingFilename
+                            << ": invalid start or end date. It is not loaded." << endl;
+            return;
         }
-    }
-    file.close();
+        putBooking(move(booking));
+    });
 }
 
-void BookingManager::saveBookings() {
-    ofstream file(bookingFilename);
+// Writes the snapshot's bookings, so it needs no stateMutex
+bool BookingManager::saveBookings(const BookingSnapshot& snapshot) {
+    if (!dataLock.isHeld()) {
+        return false;
+    }
+    // Write the full snapshot to a temporary file first so that a crash
+    // mid-write never leaves us with a truncated bookings.txt
+    string tempFilename = bookingFilename + ".tmp";
+    ofstream file(tempFilename);
     if (!file.is_open()) {
-        cout << "Error: Cannot save bookings to file." << endl;
-        return;
+        messageStream() << "Error: Cannot save bookings to file." << endl;
+        return false;
     }
     
     file << "# Booking Data Format: bookingId|renterUsername|ownerUsername|motorbikeId|startDate|endDate|status|totalCost|brand|model|color|size|plateNo" << endl;
     
-    for (const Booking& booking : bookings) {
-        file << booking.getBookingId() << "|"
-             << booking.getRenterUsername() << "|"
-             << booking.getOwnerUsername() << "|"
-             << booking.getMotorbikeId() << "|"
-             << booking.getStartDate() << "|"
-             << booking.getEndDate() << "|"
-             << booking.getStatus() << "|"
-             << booking.getTotalCost() << "|"
-             << booking.getBrand() << "|"
-             << booking.getModel() << "|"
-             << booking.getColor() << "|"
-             << booking.getSize() << "|"
-             << booking.getPlateNo() << endl;
+    for (const Booking& booking : snapshot.viewBookings()) {
+        file << formatBookingRecord(booking) << "\n";
     }
     file.close();
+    if (file.fail()) {
+        messageStream() << "Error: Cannot save bookings to file." << endl;
+        return false;
+    }
+    
+#ifdef _WIN32
+    remove(bookingFilename.c_str()); // rename() does not replace existing files on Windows
+#endif
+    if (rename(tempFilename.c_str(), bookingFilename.c_str()) != 0) {
+        messageStream() << "Error: Cannot save bookings to file." << endl;
+        return false;
+    }
+    return true;
 }
 
-void BookingManager::loadMotorbikes() {
-    ifstream file(motorbikeFilename);
-    if (!file.is_open()) {
+// Returns the number of records applied, which count towards compaction
+int BookingManager::replayJournal() {
+    int applied = 0;
+    Booking booking;
+    Journal::replay(journal.getFilename(), [&](const string& line) {
+        if (line.size() < 2 || line[1] != '|') return;
+        
+        if (line[0] == 'C') {
+            // New booking: upsert, so records already folded into the snapshot are harmless
+            if (parseBookingRecord(string_view(line).substr(2), booking)) {
+                putBooking(move(booking));
+                applied++;
+            }
+        } else if (line[0] == 'S') {
+            size_t sep = line.find('|', 2);
+            if (sep == string::npos) return;
+            
+            // Changes already folded into the loaded state are not valid transitions and are
+            // skipped; only applied records count towards compaction
+            BookingStatus status;
+            Booking* existing = findBooking(line.substr(2, sep - 2));
+            if (existing && parseBookingStatus(trimField(string_view(line).substr(sep + 1)), status) &&
+                transitionBooking(*existing, status)) {
+                applied++;
+            }
+        } else if (line[0] == 'A') {
+            size_t sep = line.find('|', 2);
+            if (sep == string::npos) return;
+            
+            Motorbike* motorbike = findMotorbike(line.substr(2, sep - 2));
+            if (motorbike) {
+                motorbike->setIsAvailable(trimField(string_view(line).substr(sep + 1)) == "1");
+                syncCatalog(*motorbike);
+                applied++;
+            }
+        } else if (line[0] == 'L') {
+            // Listing added or changed: upsert, like C records
+            string_view fields[MAX_RECORD_FIELDS];
+            if (splitRecord(trimField(string_view(line).substr(2)), fields, MAX_RECORD_FIELDS) < 16) return;
+            Motorbike motorbike = motorbikeFromFields(fields);
+            if (Motorbike* existing = findMotorbike(motorbike.getMotorbikeId())) {
+                *existing = move(motorbike);
+                syncCatalog(*existing);
+                applied++;
+            } else if (putMotorbike(move(motorbike))) {
+                applied++;
+            }
+        } else if (line[0] == 'K') {
+            // Auth applies these; kept here so compaction carries them over
+            noteCreditRecord(line + "\n");
+            applied++;
+        }
+    });
+    return applied;
+}
+
+// Appends a change's records in the order of the changes: call under
+// stateMutex, in the critical section that makes the change and publishes
+// it, then pass the result to commitJournal once stateMutex is released
+uint64_t BookingManager::queueJournal(const string& records, int count) {
+    if (groupCommitOpen) {
+        groupJournal += records;
+        groupJournalRecords += count;
+        return 0;
+    }
+    return journal.append(records, count);
+}
+
+// Returns once the records up to sequence are on the disk, usually with one
+// write shared by every thread committing at the time, or false when they
+// could not be written; call with no lock held. The change stays applied
+// in memory and is written with the next commit or compaction.
+bool BookingManager::commitJournal(uint64_t sequence) {
+    if (groupCommitOpen) {
+        return true; // endGroupCommit writes it
+    }
+    if (!journal.isOpen()) {
+        // No journal available - fall back to rewriting the whole files
+        lock_guard<mutex> compacting(compactMutex);
+        return compactJournal();
+    }
+    if (!journal.commit(sequence)) {
+        messageStream() << "Error: Cannot write booking journal." << endl;
+        return false;
+    }
+    compactJournalIfDue();
+    return true;
+}
+
+// Periodically fold the journal back into the data files to bound replay time
+void BookingManager::compactJournalIfDue() {
+    if (journal.records() < JOURNAL_COMPACT_THRESHOLD) {
         return;
     }
+    unique_lock<mutex> compacting(compactMutex, try_to_lock);
+    if (compacting.owns_lock() && journal.records() >= JOURNAL_COMPACT_THRESHOLD) {
+        compactJournal(); // Otherwise another thread is already at it
+    }
+}
+
+// Writes bookings.txt and motorbikes.txt and drops the journal records they
+// now contain; call with compactMutex held and no other lock. The state is
+// pinned together with the journal position it reflects and written without
+// stateMutex, so changes carry on meanwhile and stay in the journal. Each
+// user's latest K record is carried over until account.txt contains it.
+bool BookingManager::compactJournal() {
+    unique_lock<mutex> state(stateMutex);
+    Published<BookingSnapshot>::Pin snapshot = published.read();
+    uint64_t through = journal.lastSequence();
+    string carried;
+    int carriedCount = 0;
+    for (auto it = journalCredits.begin(); it != journalCredits.end();) {
+        if (it->second.first <= creditWatermark) {
+            it = journalCredits.erase(it);
+        } else {
+            carried += it->second.second;
+            carriedCount++;
+            ++it;
+        }
+    }
+    state.unlock();
     
-    string line;
-    while (getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        
-        // Trim whitespace
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-        
-        if (line.empty()) continue;
-        
-        stringstream ss(line);
-        string token;
-        vector<string> tokens;
-        
-        while (getline(ss, token, '|')) {
-            token.erase(0, token.find_first_not_of(" \t\r\n"));
-            token.erase(token.find_last_not_of(" \t\r\n") + 1);
-            tokens.push_back(token);
+    // Everything up to the pinned state is written first: a crash before the
+    // rewrite then replays all of it over the new files, never an older
+    // availability record without the ones that followed it
+    journal.commit(through);
+    if (!saveBookings(*snapshot)) {
+        return false;
+    }
+    {
+        lock_guard<mutex> lock(motorbikeFileMutex);
+        if (snapshot->getVersion() > savedMotorbikeVersion) {
+            if (!writeMotorbikes(*snapshot)) {
+                return false;
+            }
+            savedMotorbikeVersion = snapshot->getVersion();
         }
-        
-        if (tokens.size() >= 16) {
-            Motorbike motorbike(tokens[0], tokens[1], tokens[2], tokens[3], tokens[4], tokens[5],
-                               tokens[6], stod(tokens[7]), tokens[8], tokens[9] == "1", stod(tokens[10]),
-                               tokens[11], tokens[12], tokens[13], stod(tokens[14]), tokens[15] == "1");
-            motorbikes.push_back(motorbike);
+    }
+    if (journal.isOpen()) {
+        journal.rewrite(carried, carriedCount, through);
+    }
+    return true;
+}
+
+// Keeps each user's latest K record for compaction; call under stateMutex
+void BookingManager::noteCreditRecord(const string& record) {
+    uint64_t change;
+    string username;
+    double creditPoints;
+    if (Auth::parseCreditRecord(record, change, username, creditPoints)) {
+        pair<uint64_t, string>& latest = journalCredits[username];
+        if (change > latest.first) {
+            latest = make_pair(change, record);
         }
     }
-    file.close();
 }
 
-void BookingManager::saveMotorbikes() {
-    ofstream file(motorbikeFilename);
-    if (!file.is_open()) {
-        cout << "Error: Cannot save motorbikes to file." << endl;
+string BookingManager::statusRecord(const Booking& booking) const {
+    return "S|" + booking.getBookingId() + "|" + booking.getStatus() + "\n";
+}
+
+string BookingManager::availabilityRecord(const Motorbike& motorbike) const {
+    return "A|" + motorbike.getMotorbikeId() + (motorbike.getIsAvailable() ? "|1\n" : "|0\n");
+}
+
+string BookingManager::formatBookingRecord(const Booking& booking) const {
+    ostringstream record;
+    record << booking.getBookingId() << "|"
+           << booking.getRenterUsername() << "|"
+           << booking.getOwnerUsername() << "|"
+           << booking.getMotorbikeId() << "|"
+           << booking.getStartDate() << "|"
+           << booking.getEndDate() << "|"
+           << booking.getStatus() << "|"
+           << booking.getTotalCost() << "|"
+           << booking.getBrand() << "|"
+           << booking.getModel() << "|"
+           << booking.getColor() << "|"
+           << booking.getSize() << "|"
+           << booking.getPlateNo();
+    return record.str();
+}
+
+bool BookingManager::parseBookingRecord(string_view text, Booking& booking) const {
+    string_view line = trimField(text);
+    if (line.empty() || line[0] == '#') return false;
+    
+    string_view fields[MAX_RECORD_FIELDS];
+    if (splitRecord(line, fields, MAX_RECORD_FIELDS) < 13) return false;
+    
+    booking = bookingFromFields(fields);
+    if (!booking.getStart().isValid() || !booking.getEnd().isValid()) {
+        messageStream() << "Skipping booking " << booking.getBookingId() << " in " << journal.getFilename()
+                        << ": invalid start or end date." << endl;
+        return false;
+    }
+    return true;
+}
+
+void BookingManager::putBooking(Booking booking) {
+    // One hash lookup for both outcomes: bulk loads are almost all inserts
+    auto entry = bookingIndex.try_emplace(booking.getBookingId(), bookings.size());
+    if (!entry.second) {
+        size_t slot = entry.first->second;
+        unindexBooking(slot);
+        if (bookings[slot].getRenterUsername() != booking.getRenterUsername()) {
+            vector<size_t>& previous = renterBookings[bookings[slot].getRenterUsername()];
+            previous.erase(find(previous.begin(), previous.end(), slot));
+            vector<size_t>& current = renterBookings[booking.getRenterUsername()];
+            current.insert(lower_bound(current.begin(), current.end(), slot), slot);
+        }
+        bookings.mutate(slot) = move(booking);
+        indexBooking(slot);
         return;
     }
+    size_t slot = entry.first->second;
+    renterBookings[booking.getRenterUsername()].push_back(slot);
+    bookings.push_back(move(booking));
+    indexBooking(slot);
+}
+
+Booking* BookingManager::findBooking(const string& bookingId) {
+    auto it = bookingIndex.find(bookingId);
+    return it != bookingIndex.end() ? &bookings.mutate(it->second) : nullptr;
+}
+
+Motorbike* BookingManager::findMotorbike(const string& motorbikeId) {
+    auto it = motorbikeIndex.find(motorbikeId);
+    return it != motorbikeIndex.end() ? &motorbikes.mutate(it->second) : nullptr;
+}
+
+// Publishes the current tables as a new BookingSnapshot; called once at the
+// end of every public change so readers never see one half-applied
+void BookingManager::publishSnapshot() {
+    if (groupCommitOpen) {
+        groupPublishPending = true;
+        return;
+    }
+    published.publish(unique_ptr<const BookingSnapshot>(new BookingSnapshot(
+        motorbikes, bookings, catalog, renterBookings, ownerRequests, locations, ++publishedVersion)));
+}
+
+void BookingManager::beginGroupCommit(Auth& auth) {
+    groupCommitOpen = true;
+    auth.beginGroupCommit();
+}
+
+// The batch's credit changes made through Auth join its booking records, so
+// the whole batch is one journal append
+bool BookingManager::endGroupCommit(Auth& auth) {
+    string credits = auth.endGroupCommit();
+    uint64_t sequence = 0;
+    {
+        lock_guard<mutex> state(stateMutex);
+        groupCommitOpen = false;
+        creditWatermark = auth.getSavedCreditChanges();
+        for (size_t start = 0, end; (end = credits.find('\n', start)) != string::npos; start = end + 1) {
+            noteCreditRecord(credits.substr(start, end + 1 - start));
+            groupJournalRecords++;
+        }
+        groupJournal += credits;
+        if (groupJournalRecords > 0) {
+            sequence = queueJournal(groupJournal, groupJournalRecords);
+            groupJournal.clear();
+            groupJournalRecords = 0;
+        }
+        if (groupPublishPending) {
+            groupPublishPending = false;
+            publishSnapshot();
+        }
+    }
+    bool saved = commitJournal(sequence);
+    if (!journal.isOpen()) {
+        auth.saveUsers(); // The credit changes have no journal record to live in
+    }
+    auth.saveCreditsIfDue();
+    return saved;
+}
+
+// The lock on m, or none while a group commit is open: its caller is then
+// the only thread changing anything
+unique_lock<mutex> BookingManager::writerLock(mutex& m) {
+    return groupCommitOpen ? unique_lock<mutex>(m, defer_lock) : unique_lock<mutex>(m);
+}
+
+// Releases a lock taken with writerLock, which may hold nothing
+static void release(unique_lock<mutex>& lock) {
+    if (lock.owns_lock()) {
+        lock.unlock();
+    }
+}
+
+size_t BookingManager::motorbikeStripe(const string& motorbikeId) const {
+    return hash<string>()(motorbikeId) % MOTORBIKE_LOCK_STRIPES;
+}
+
+// The motorbike a booking is for, which names the lock to take before
+// deciding on it; a booking never moves to another motorbike
+bool BookingManager::findBookingMotorbike(const string& bookingId, string& motorbikeId) {
+    unique_lock<mutex> state = writerLock(stateMutex);
+    auto it = bookingIndex.find(bookingId);
+    if (it == bookingIndex.end()) {
+        return false;
+    }
+    motorbikeId = bookings[it->second].getMotorbikeId();
+    return true;
+}
+
+// All status changes go through here so the indexes follow them
+bool BookingManager::transitionBooking(Booking& booking, BookingStatus next) {
+    static const TransitionHook hooks[BOOKING_STATUS_COUNT][BOOKING_STATUS_COUNT] = {
+        {nullptr, &BookingManager::onApproved, &BookingManager::onRejected, nullptr},
+        {nullptr, nullptr, nullptr, &BookingManager::onCompleted},
+        {nullptr, nullptr, nullptr, nullptr},
+        {nullptr, nullptr, nullptr, nullptr},
+    };
+    
+    BookingStatus current = booking.getStatusCode();
+    if (!booking.transitionTo(next)) {
+        return false;
+    }
+    TransitionHook hook = hooks[static_cast<size_t>(current)][static_cast<size_t>(next)];
+    if (hook) {
+        (this->*hook)(bookingIndex.find(booking.getBookingId())->second);
+    }
+    return true;
+}
+
+void BookingManager::onApproved(size_t slot) {
+    const Booking& booking = bookings[slot];
+    MotorbikeSchedule& schedule = schedules[booking.getMotorbikeId()];
+    schedule.pending.erase(booking.getStart(), slot);
+    schedule.approved.insert(booking.getStart(), booking.getEnd(), slot);
+    ownerRequests[booking.getOwnerUsername()].erase(slot);
+    renterActiveRentals[booking.getRenterUsername()]++;
+    ownerActiveRentals[booking.getOwnerUsername()]++;
+    markOccupied(booking);
+}
+
+void BookingManager::onRejected(size_t slot) {
+    const Booking& booking = bookings[slot];
+    schedules[booking.getMotorbikeId()].pending.erase(booking.getStart(), slot);
+    ownerRequests[booking.getOwnerUsername()].erase(slot);
+}
+
+void BookingManager::onCompleted(size_t slot) {
+    const Booking& booking = bookings[slot];
+    schedules[booking.getMotorbikeId()].approved.erase(booking.getStart(), slot);
+    renterActiveRentals[booking.getRenterUsername()]--;
+    ownerActiveRentals[booking.getOwnerUsername()]--;
+    refreshOccupancy(booking.getMotorbikeId());
+}
+
+void BookingManager::indexBooking(size_t slot) {
+    const Booking& booking = bookings[slot];
+    if (booking.isApproved()) {
+        schedules[booking.getMotorbikeId()].approved.insert(booking.getStart(), booking.getEnd(), slot);
+        renterActiveRentals[booking.getRenterUsername()]++;
+        ownerActiveRentals[booking.getOwnerUsername()]++;
+        markOccupied(booking);
+    } else if (booking.isPending()) {
+        schedules[booking.getMotorbikeId()].pending.insert(booking.getStart(), booking.getEnd(), slot);
+        ownerRequests[booking.getOwnerUsername()].insert(slot);
+    }
+}
+
+void BookingManager::unindexBooking(size_t slot) {
+    const Booking& booking = bookings[slot];
+    if (booking.isApproved()) {
+        schedules[booking.getMotorbikeId()].approved.erase(booking.getStart(), slot);
+        renterActiveRentals[booking.getRenterUsername()]--;
+        ownerActiveRentals[booking.getOwnerUsername()]--;
+        refreshOccupancy(booking.getMotorbikeId());
+    } else if (booking.isPending()) {
+        schedules[booking.getMotorbikeId()].pending.erase(booking.getStart(), slot);
+        ownerRequests[booking.getOwnerUsername()].erase(slot);
+    }
+}
+
+void BookingManager::loadMotorbikes() {
+    MappedFile file(motorbikeFilename);
+    if (!file.isOpen()) {
+        return;
+    }
+    
+    size_t lineCount = countLines(file.view());
+    motorbikeIndex.reserve(lineCount);
+    catalog.reserve(lineCount);
+    forEachRecord(file.view(), [this](const string_view* fields, size_t count) {
+        if (count >= 16) {
+            putMotorbike(motorbikeFromFields(fields));
+        }
+    });
+}
+
+// Rewrites motorbikes.txt through a temporary file; call with motorbikeFileMutex held
+bool BookingManager::writeMotorbikes(const BookingSnapshot& snapshot) {
+    if (!dataLock.isHeld()) {
+        return false;
+    }
+    string tempFilename = motorbikeFilename + ".tmp";
+    ofstream file(tempFilename);
+    if (!file.is_open()) {
+        messageStream() << "Error: Cannot save motorbikes to file." << endl;
+        return false;
+    }
     
     file << "# Motorbike Data Format: motorbikeId|ownerUsername|brand|model|color|size|plateNo|pricePerDay|location|isAvailable|rating|description|availableStartDate|availableEndDate|minRenterRating|isListed" << endl;
     
-    for (const Motorbike& motorbike : motorbikes) {
-        file << motorbike.getMotorbikeId() << "|"
-             << motorbike.getOwnerUsername() << "|"
-             << motorbike.getBrand() << "|"
-             << motorbike.getModel() << "|"
-             << motorbike.getColor() << "|"
-             << motorbike.getSize() << "|"
-             << motorbike.getPlateNo() << "|"
-             << motorbike.getPricePerDay() << "|"
-             << motorbike.getLocation() << "|"
-             << (motorbike.getIsAvailable() ? "1" : "0") << "|"
-             << motorbike.getRating() << "|"
-             << motorbike.getDescription() << "|"
-             << motorbike.getAvailableStartDate() << "|"
-             << motorbike.getAvailableEndDate() << "|"
-             << motorbike.getMinRenterRating() << "|"
-             << (motorbike.getIsListed() ? "1" : "0") << endl;
+    for (const Motorbike& motorbike : snapshot.viewMotorbikes()) {
+        file << formatMotorbikeRecord(motorbike) << "\n";
     }
     file.close();
+    if (file.fail()) {
+        messageStream() << "Error: Cannot save motorbikes to file." << endl;
+        return false;
+    }
+    
+#ifdef _WIN32
+    remove(motorbikeFilename.c_str()); // rename() does not replace existing files on Windows
+#endif
+    if (rename(tempFilename.c_str(), motorbikeFilename.c_str()) != 0) {
+        messageStream() << "Error: Cannot save motorbikes to file." << endl;
+        return false;
+    }
+    return true;
+}
+
+string BookingManager::formatMotorbikeRecord(const Motorbike& motorbike) const {
+    ostringstream record;
+    record << motorbike.getMotorbikeId() << "|"
+           << motorbike.getOwnerUsername() << "|"
+           << motorbike.getBrand() << "|"
+           << motorbike.getModel() << "|"
+           << motorbike.getColor() << "|"
+           << motorbike.getSize() << "|"
+           << motorbike.getPlateNo() << "|"
+           << motorbike.getPricePerDay() << "|"
+           << motorbike.getLocation() << "|"
+           << (motorbike.getIsAvailable() ? "1" : "0") << "|"
+           << motorbike.getRating() << "|"
+           << motorbike.getDescription() << "|"
+           << motorbike.getAvailableStartDate() << "|"
+           << motorbike.getAvailableEndDate() << "|"
+           << motorbike.getMinRenterRating() << "|"
+           << (motorbike.getIsListed() ? "1" : "0");
+    return record.str();
 }
 
 string BookingManager::generateBookingId() {
-    return "BK" + to_string(bookings.size() + 1);
+    // Skip ids already taken so the id index never maps two records to one id
+    size_t number = bookings.size() + 1;
+    while (bookingIndex.count("BK" + to_string(number))) {
+        number++;
+    }
+    return "BK" + to_string(number);
 }
 
 string BookingManager::generateMotorbikeId() {
-    return "MB" + to_string(motorbikes.size() + 1);
+    size_t number = motorbikes.size() + 1;
+    while (motorbikeIndex.count("MB" + to_string(number))) {
+        number++;
+    }
+    return "MB" + to_string(number);
+}
+
+// Checks one rental request against the current state, in the order the
+// user-facing messages expect; totalCost is set once the dates are valid
+BookingError BookingManager::checkBookingRequest(const string& renter, const Motorbike* motorbike,
+                                                 Date start, Date end, Auth& auth, double& totalCost) {
+    if (!motorbike) {
+        return BookingError::MotorbikeNotFound;
+    }
+    if (!start.isValid() || !end.isValid() || end < start) {
+        return BookingError::InvalidDates;
+    }
+    if (auth.getUserRenterRating(renter) < motorbike->getMinRenterRating()) {
+        return BookingError::RatingTooLow;
+    }
+    totalCost = calculateTotalCost(*motorbike, start, end);
+    if (auth.getUserCreditPoints(renter) < totalCost) {
+        return BookingError::InsufficientCredits;
+    }
+    if (hasActiveRental(renter)) {
+        return BookingError::ActiveRental;
+    }
+    int engineSize = motorbike->getEngineSize();
+    if (engineSize > 50 && !hasValidLicense(renter, auth, engineSize)) {
+        return BookingError::LicenseRequired;
+    }
+    if (!motorbike->isAvailableForDateRange(start, end)) {
+        return BookingError::OutsideAvailability;
+    }
+    if (hasOverlappingApprovedBookings(motorbike->getMotorbikeId(), start, end)) {
+        return BookingError::AlreadyBooked;
+    }
+    return BookingError::None;
+}
+
+Booking BookingManager::makeBooking(const string& renter, const Motorbike& motorbike, Date start, Date end,
+                                    double totalCost) {
+    Booking booking(generateBookingId(), renter, motorbike.getOwnerUsername(), motorbike.getMotorbikeId(),
+                    "", "", "Pending", totalCost, motorbike.getBrand(), motorbike.getModel(),
+                    motorbike.getColor(), motorbike.getSize(), motorbike.getPlateNo());
+    booking.setStartDate(start);
+    booking.setEndDate(end);
+    return booking;
 }
 
 bool BookingManager::createBooking(const string& renter, const string& motorbikeId,
                                   const string& startDate, const string& endDate, Auth& auth) {
-    // Find the motorbike
-    Motorbike* motorbike = getMotorbikeById(motorbikeId);
-    if (!motorbike) {
-        cout << "Motorbike not found." << endl;
-        return false;
+    unique_lock<mutex> motorbikeLock = writerLock(motorbikeLocks[motorbikeStripe(motorbikeId)]);
+    unique_lock<mutex> state = writerLock(stateMutex);
+    const Motorbike* motorbike = getMotorbikeById(motorbikeId);
+    Date start = Date::parse(startDate);
+    Date end = Date::parse(endDate);
+    double totalCost = 0.0;
+    BookingError error = checkBookingRequest(renter, motorbike, start, end, auth, totalCost);
+    switch (error) {
+        case BookingError::None:
+            break;
+        case BookingError::RatingTooLow:
+            messageStream() << "Your rating (" << auth.getUserRenterRating(renter) << ") is below the required rating (" 
+                 << motorbike->getMinRenterRating() << ")." << endl;
+            return false;
+        case BookingError::InsufficientCredits:
+            messageStream() << "Insufficient credit points. Required: " << totalCost 
+                 << " CP, Available: " << auth.getUserCreditPoints(renter) << " CP." << endl;
+            return false;
+        default:
+            messageStream() << bookingErrorMessage(error) << endl;
+            return false;
     }
     
-    // Validate renter requirements
-    double renterRating = auth.getUserRenterRating(renter);
-    if (renterRating < motorbike->getMinRenterRating()) {
-        cout << "Your rating (" << renterRating << ") is below the required rating (" 
-             << motorbike->getMinRenterRating() << ")." << endl;
+    Booking booking = makeBooking(renter, *motorbike, start, end, totalCost);
+    string bookingId = booking.getBookingId();
+    putBooking(booking);
+    publishSnapshot();
+    uint64_t sequence = queueJournal("C|" + formatBookingRecord(booking) + "\n", 1);
+    release(state);
+    release(motorbikeLock);
+    if (!commitJournal(sequence)) {
         return false;
     }
     
-    double totalCost = calculateTotalCost(*motorbike, startDate, endDate);
-    double renterCPs = auth.getUserCreditPoints(renter);
-    if (renterCPs < totalCost) {
-        cout << "Insufficient credit points. Required: " << totalCost 
-             << " CP, Available: " << renterCPs << " CP." << endl;
-        return false;
+    messageStream() << "Rental request submitted successfully!" << endl;
+    messageStream() << "Booking ID: " << bookingId << endl;
+    messageStream() << "Total Cost: " << totalCost << " CP" << endl;
+    messageStream() << "Status: Pending approval from owner" << endl;
+    
+    return true;
+}
+
+// Creates many bookings at once. Every request is checked against the state
+// before the batch; among the accepted ones, a request overlapping an earlier
+// request of the batch for the same motorbike is refused with BatchConflict.
+// The accepted bookings are journaled with one append, written after the
+// locks are released.
+vector<BookingResult> BookingManager::createBookings(const vector<BookingRequest>& batch, Auth& auth) {
+    // The stripes of every motorbike in the batch, in ascending order so two
+    // batches sharing motorbikes cannot deadlock
+    vector<unique_lock<mutex>> motorbikeLock;
+    if (!groupCommitOpen) {
+        vector<size_t> stripes;
+        for (const BookingRequest& request : batch) {
+            stripes.push_back(motorbikeStripe(request.motorbikeId));
+        }
+        sort(stripes.begin(), stripes.end());
+        stripes.erase(unique(stripes.begin(), stripes.end()), stripes.end());
+        motorbikeLock.reserve(stripes.size());
+        for (size_t stripe : stripes) {
+            motorbikeLock.emplace_back(motorbikeLocks[stripe]);
+        }
     }
+    unique_lock<mutex> state = writerLock(stateMutex);
+    creditWatermark = auth.getSavedCreditChanges();
     
-    // Check for active rentals
-    if (hasActiveRental(renter)) {
-        cout << "You already have an active rental." << endl;
-        return false;
+    vector<BookingResult> results(batch.size());
+    unordered_map<string, IntervalTree<Date, size_t>> accepted; // motorbikeId -> accepted periods
+    vector<Booking> created;
+    created.reserve(batch.size());
+    
+    for (size_t i = 0; i < batch.size(); i++) {
+        const BookingRequest& request = batch[i];
+        BookingResult& result = results[i];
+        const Motorbike* motorbike = getMotorbikeById(request.motorbikeId);
+        Date start = Date::parse(request.startDate);
+        Date end = Date::parse(request.endDate);
+        result.error = checkBookingRequest(request.renter, motorbike, start, end, auth, result.totalCost);
+        if (result.error != BookingError::None) {
+            continue;
+        }
+        
+        IntervalTree<Date, size_t>& periods = accepted[request.motorbikeId];
+        if (periods.overlaps(start, end)) {
+            result.error = BookingError::BatchConflict;
+            continue;
+        }
+        periods.insert(start, end, i);
+        
+        // Indexed right away so generateBookingId skips the ids already handed out
+        created.push_back(makeBooking(request.renter, *motorbike, start, end, result.totalCost));
+        result.bookingId = created.back().getBookingId();
+        putBooking(created.back());
     }
     
-    // Check license requirement
-    int engineSize = motorbike->getEngineSize();
-    if (engineSize > 50 && !hasValidLicense(renter, auth, engineSize)) {
-        cout << "Valid license required for motorbikes over 50cc." << endl;
+    if (!created.empty()) {
+        string records;
+        for (const Booking& booking : created) {
+            records += "C|" + formatBookingRecord(booking) + "\n";
+        }
+        publishSnapshot();
+        uint64_t sequence = queueJournal(records, static_cast<int>(created.size()));
+        release(state);
+        motorbikeLock.clear();
+        if (!commitJournal(sequence)) {
+            for (BookingResult& result : results) {
+                if (result.created()) {
+                    result.error = BookingError::NotSaved;
+                }
+            }
+        }
+    }
+    return results;
+}
+
+// The approval, the renter's credit charge and the motorbike's availability
+// are journaled as one append, so a crash keeps all of them or none. The
+// renter's credit lock is held until that append is written, so an
+// account.txt rewrite cannot contain the charge first (see
+// Auth::chargeCreditPoints).
+bool BookingManager::approveBooking(const string& bookingId, const string& owner, Auth& auth) {
+    string motorbikeId;
+    if (!findBookingMotorbike(bookingId, motorbikeId)) {
         return false;
     }
+    unique_lock<mutex> motorbikeLock = writerLock(motorbikeLocks[motorbikeStripe(motorbikeId)]);
+    unique_lock<mutex> state = writerLock(stateMutex);
     
-    // Check date availability
-    if (!motorbike->isAvailableForDateRange(startDate, endDate)) {
-        cout << "Motorbike not available for the selected date range." << endl;
+    const Booking& request = bookings[bookingIndex.find(bookingId)->second];
+    if (request.getOwnerUsername() != owner || !request.isPending()) {
         return false;
     }
-    
     // Check for overlapping approved bookings
-    if (hasOverlappingApprovedBookings(motorbikeId, startDate, endDate)) {
-        cout << "Motorbike already booked for this period." << endl;
+    if (hasOverlappingApprovedBookings(motorbikeId, request.getStart(), request.getEnd())) {
+        messageStream() << "Cannot approve: overlapping booking exists." << endl;
         return false;
     }
+    double totalCost = request.getTotalCost();
     
-    // Create booking
-    string bookingId = generateBookingId();
-    Booking booking(bookingId, renter, motorbike->getOwnerUsername(), motorbikeId,
-                   startDate, endDate, "Pending", totalCost, motorbike->getBrand(),
-                   motorbike->getModel(), motorbike->getColor(), motorbike->getSize(),
-                   motorbike->getPlateNo());
+    // Deduct credit points
+    unique_lock<mutex> creditHold;
+    string records;
+    if (!auth.chargeCreditPoints(request.getRenterUsername(), totalCost, creditHold, records)) {
+        messageStream() << "Failed to deduct credit points." << endl;
+        return false;
+    }
+    noteCreditRecord(records);
+    creditWatermark = auth.getSavedCreditChanges();
     
-    bookings.push_back(booking);
-    saveBookings();
+    // Update booking status
+    Booking& booking = *findBooking(bookingId);
+    transitionBooking(booking, BookingStatus::Approved);
+    records += statusRecord(booking);
+    int count = 2;
     
-    cout << "Rental request submitted successfully!" << endl;
-    cout << "Booking ID: " << bookingId << endl;
-    cout << "Total Cost: " << totalCost << " CP" << endl;
-    cout << "Status: Pending approval from owner" << endl;
+    // Reject overlapping requests
+    count += rejectOverlappingRequests(motorbikeId, booking.getStart(), booking.getEnd(), bookingId, records);
     
-    return true;
-}
-
-bool BookingManager::approveBooking(const string& bookingId, const string& owner, Auth& auth) {
-    for (Booking& booking : bookings) {
-        if (booking.getBookingId() == bookingId && booking.getOwnerUsername() == owner && booking.isPending()) {
-            // Check for overlapping approved bookings
-            if (hasOverlappingApprovedBookings(booking.getMotorbikeId(), booking.getStartDate(), booking.getEndDate())) {
-                cout << "Cannot approve: overlapping booking exists." << endl;
-                return false;
-            }
-            
-            // Deduct credit points
-            if (!auth.deductCreditPoints(booking.getRenterUsername(), booking.getTotalCost())) {
-                cout << "Failed to deduct credit points." << endl;
-                return false;
-            }
-            
-            // Update booking status
-            booking.setStatus("Approved");
-            
-            // Reject overlapping requests
-            rejectOverlappingRequests(booking.getMotorbikeId(), booking.getStartDate(), 
-                                    booking.getEndDate(), bookingId);
-            
-            // Mark motorbike as unavailable
-            Motorbike* motorbike = getMotorbikeById(booking.getMotorbikeId());
-            if (motorbike) {
-                motorbike->setIsAvailable(false);
-            }
-            
-            saveBookings();
-            saveMotorbikes();
-            
-            cout << "Booking approved successfully!" << endl;
-            cout << "Credit points deducted: " << booking.getTotalCost() << " CP" << endl;
-            
-            return true;
-        }
+    // Mark motorbike as unavailable
+    Motorbike* motorbike = findMotorbike(motorbikeId);
+    if (motorbike) {
+        motorbike->setIsAvailable(false);
+        syncCatalog(*motorbike);
+        records += availabilityRecord(*motorbike);
+        count++;
+    }
+    publishSnapshot();
+    uint64_t sequence = queueJournal(records, count);
+    release(state);
+    release(motorbikeLock);
+    
+    journal.commit(sequence);
+    creditHold = unique_lock<mutex>();
+    bool saved = commitJournal(sequence); // Already written unless that failed; compacts when due
+    if (!journal.isOpen() && !groupCommitOpen) {
+        auth.saveUsers(); // The charge has no journal record to live in
+    }
+    auth.saveCreditsIfDue();
+    if (!saved) {
+        return false;
     }
-    return false;
+    
+    messageStream() << "Booking approved successfully!" << endl;
+    messageStream() << "Credit points deducted: " << totalCost << " CP" << endl;
+    
+    return true;
 }
 
 bool BookingManager::rejectBooking(const string& bookingId, const string& owner) {
-    for (Booking& booking : bookings) {
-        if (booking.getBookingId() == bookingId && booking.getOwnerUsername() == owner && booking.isPending()) {
-            booking.setStatus("Rejected");
-            saveBookings();
-            cout << "Booking rejected." << endl;
-            return true;
+    string motorbikeId;
+    if (!findBookingMotorbike(bookingId, motorbikeId)) {
+        return false;
+    }
+    unique_lock<mutex> motorbikeLock = writerLock(motorbikeLocks[motorbikeStripe(motorbikeId)]);
+    unique_lock<mutex> state = writerLock(stateMutex);
+    
+    Booking* booking = findBooking(bookingId);
+    if (booking->getOwnerUsername() == owner && booking->isPending()) {
+        transitionBooking(*booking, BookingStatus::Rejected);
+        publishSnapshot();
+        uint64_t sequence = queueJournal(statusRecord(*booking), 1);
+        release(state);
+        release(motorbikeLock);
+        if (!commitJournal(sequence)) {
+            return false;
         }
+        messageStream() << "Booking rejected." << endl;
+        return true;
     }
     return false;
 }
 
 vector<Booking> BookingManager::getUserBookings(const string& username) {
     vector<Booking> userBookings;
-    for (const Booking& booking : bookings) {
-        if (booking.getRenterUsername() == username) {
-            userBookings.push_back(booking);
-        }
-    }
+    forEachUserBooking(username, [&](const Booking& booking) {
+        userBookings.push_back(booking);
+    });
     return userBookings;
 }
 
 vector<Booking> BookingManager::getUserRentalRequests(const string& username) {
     vector<Booking> requests;
-    for (const Booking& booking : bookings) {
-        if (booking.getOwnerUsername() == username && booking.isPending()) {
-            requests.push_back(booking);
-        }
-    }
+    forEachRentalRequest(username, [&](const Booking& booking) {
+        requests.push_back(booking);
+    });
     return requests;
 }
 
 vector<Booking> BookingManager::getAllBookings() {
-    return bookings;
+    return vector<Booking>(bookings.begin(), bookings.end());
 }
 
 bool BookingManager::addMotorbike(const Motorbike& motorbike) {
-    motorbikes.push_back(motorbike);
-    saveMotorbikes();
-    return true;
+    if (!putMotorbike(motorbike)) {
+        return false; // Duplicate motorbike id
+    }
+    return journalListing(motorbike);
 }
 
-vector<Motorbike> BookingManager::getAvailableMotorbikes() {
-    vector<Motorbike> available;
-    for (const Motorbike& motorbike : motorbikes) {
-        if (motorbike.getIsAvailable() && motorbike.getIsListed()) {
-            available.push_back(motorbike);
-        }
+// Publishes a new or changed listing and journals it as an L record, which
+// a group commit writes in the same append as the rest of its batch
+bool BookingManager::journalListing(const Motorbike& motorbike) {
+    uint64_t sequence;
+    {
+        unique_lock<mutex> state = writerLock(stateMutex);
+        publishSnapshot();
+        sequence = queueJournal("L|" + formatMotorbikeRecord(motorbike) + "\n", 1);
     }
-    return available;
+    return commitJournal(sequence);
+}
+
+vector<Motorbike> BookingManager::getAvailableMotorbikes() {
+    MotorbikeRange available = viewAvailableMotorbikes();
+    return vector<Motorbike>(available.begin(), available.end());
 }
 
 vector<Motorbike> BookingManager::getAllMotorbikes() {
-    return motorbikes; // Return all motorbikes for admin view
+    return vector<Motorbike>(motorbikes.begin(), motorbikes.end()); // Return all motorbikes for admin view
 }
 
 vector<Motorbike> BookingManager::getGuestMotorbikes() {
-    vector<Motorbike> guestMotorbikes;
-    for (const Motorbike& motorbike : motorbikes) {
-        if (motorbike.getIsListed()) {
-            guestMotorbikes.push_back(motorbike);
-        }
-    }
-    return guestMotorbikes;
+    MotorbikeRange listed = viewGuestMotorbikes();
+    return vector<Motorbike>(listed.begin(), listed.end());
+}
+
+BookingManager::MotorbikeRange BookingManager::viewAvailableMotorbikes() const {
+    return viewMotorbikes().where(static_cast<bool (*)(const Motorbike&)>([](const Motorbike& motorbike) {
+        return motorbike.getIsAvailable() && motorbike.getIsListed();
+    }));
+}
+
+BookingManager::MotorbikeRange BookingManager::viewGuestMotorbikes() const {
+    return viewMotorbikes().where(static_cast<bool (*)(const Motorbike&)>([](const Motorbike& motorbike) {
+        return motorbike.getIsListed();
+    }));
 }
 
 vector<Motorbike> BookingManager::getUserMotorbikes(const string& username) {
@@ -482,13 +1109,120 @@ vector<Motorbike> BookingManager::getUserMotorbikes(const string& username) {
     return userMotorbikes;
 }
 
-Motorbike* BookingManager::getMotorbikeById(const string& motorbikeId) {
-    for (Motorbike& motorbike : motorbikes) {
-        if (motorbike.getMotorbikeId() == motorbikeId) {
-            return &motorbike;
+const Motorbike* BookingManager::getMotorbikeById(const string& motorbikeId) const {
+    auto it = motorbikeIndex.find(motorbikeId);
+    return it != motorbikeIndex.end() ? &motorbikes[it->second] : nullptr;
+}
+
+bool BookingManager::putMotorbike(Motorbike newMotorbike) {
+    if (!motorbikeIndex.emplace(newMotorbike.getMotorbikeId(), motorbikes.size()).second) {
+        return false;
+    }
+    const Motorbike& motorbike = motorbikes.push_back(move(newMotorbike));
+    syncCatalog(motorbike);
+    
+    // Brand and model words weigh more than the free-text description
+    uint32_t slot = static_cast<uint32_t>(motorbikes.size() - 1);
+    textIndex.add(slot, motorbike.getBrand() + " " + motorbike.getModel(), 2.0f);
+    textIndex.add(slot, motorbike.getDescription());
+    return true;
+}
+
+// Call after changing a motorbike field that the catalog mirrors
+void BookingManager::syncCatalog(const Motorbike& motorbike) {
+    auto it = motorbikeIndex.find(motorbike.getMotorbikeId());
+    if (it == motorbikeIndex.end()) {
+        return;
+    }
+    if (find(locations.begin(), locations.end(), motorbike.getLocationId()) == locations.end()) {
+        locations.push_back(motorbike.getLocationId());
+    }
+    // Searches matching the old city/window, then those matching the new one
+    if (it->second < catalog.size()) {
+        invalidateSearches(it->second);
+    }
+    if (catalog.set(it->second, motorbike)) {
+        refreshOccupancy(motorbike.getMotorbikeId());
+    }
+    invalidateSearches(it->second);
+}
+
+// Sets the days of an approved booking in its motorbike's occupancy bitmap
+void BookingManager::markOccupied(const Booking& booking) {
+    auto it = motorbikeIndex.find(booking.getMotorbikeId());
+    if (it != motorbikeIndex.end()) {
+        catalog.setOccupied(it->second, booking.getStart().dayNumber(), booking.getEnd().dayNumber(), true);
+        invalidateSearches(it->second);
+    }
+}
+
+// Rebuilds a motorbike's occupancy bitmap from its approved bookings; used
+// when an approved booking goes away, since neighbours may share its days
+void BookingManager::refreshOccupancy(const string& motorbikeId) {
+    auto slot = motorbikeIndex.find(motorbikeId);
+    if (slot == motorbikeIndex.end()) {
+        return;
+    }
+    catalog.clearOccupancy(slot->second);
+    invalidateSearches(slot->second);
+    auto it = schedules.find(motorbikeId);
+    if (it == schedules.end()) {
+        return;
+    }
+    const Motorbike& motorbike = motorbikes[slot->second];
+    it->second.approved.forEachOverlap(motorbike.getAvailableStart(), motorbike.getAvailableEnd(),
+                                       [&](Date startDate, Date endDate, size_t) {
+        catalog.setOccupied(slot->second, startDate.dayNumber(), endDate.dayNumber(), true);
+    });
+}
+
+// Drops the cached searches a catalog row could appear in: same city, with
+// dates inside the row's availability window
+void BookingManager::invalidateSearches(size_t slot) {
+    searchCache.invalidate(catalog.cityId(slot), catalog.startDay(slot), catalog.endDay(slot));
+}
+
+// catalog.select with the renter-independent part (city, window, listed,
+// available, free) served from searchCache; the renter's rating, credits and
+// engine limit are checked on top of the cached candidates
+size_t BookingManager::selectMotorbikes(const CatalogQuery& query, vector<uint64_t>& selection) {
+    SearchCache::Key key = {query.cityId, query.startDay, query.endDay, query.requireFree};
+    const vector<uint32_t>* candidates = searchCache.find(key);
+    if (!candidates) {
+        CatalogQuery anyRenter = query;
+        anyRenter.maxEngineCc = INT32_MAX;
+        anyRenter.renterRating = numeric_limits<double>::infinity();
+        anyRenter.renterCredits = numeric_limits<double>::infinity();
+        
+        vector<uint32_t> slots;
+        slots.reserve(catalog.select(anyRenter, selection));
+        MotorbikeCatalog::forEachSelected(selection, [&](size_t slot) {
+            slots.push_back(static_cast<uint32_t>(slot));
+        });
+        candidates = searchCache.insert(key, move(slots));
+        if (!candidates) {
+            // Too large to cache; filter the fresh selection in place
+            size_t matches = 0;
+            MotorbikeCatalog::forEachSelected(selection, [&](size_t slot) {
+                if (catalog.matchesRenter(slot, query)) {
+                    matches++;
+                } else {
+                    selection[slot / 64] &= ~(1ULL << (slot % 64));
+                }
+            });
+            return matches;
         }
     }
-    return nullptr;
+    
+    selection.assign((catalog.size() + 63) / 64, 0);
+    size_t matches = 0;
+    for (uint32_t slot : *candidates) {
+        if (catalog.matchesRenter(slot, query)) {
+            selection[slot / 64] |= 1ULL << (slot % 64);
+            matches++;
+        }
+    }
+    return matches;
 }
 
 bool BookingManager::listMotorbike(const string& ownerUsername, const string& brand,
@@ -498,7 +1232,7 @@ bool BookingManager::listMotorbike(const string& ownerUsername, const string& br
                                   double minRenterRating) {
     // Check if user already has a listed motorbike
     if (isMotorbikeListed(ownerUsername)) {
-        cout << "You can only list one motorbike at a time." << endl;
+        messageStream() << "You can only list one motorbike at a time." << endl;
         return false;
     }
     
@@ -514,30 +1248,36 @@ bool BookingManager::listMotorbike(const string& ownerUsername, const string& br
                        pricePerDay, location, true, 0.0, description, availableStartDate,
                        availableEndDate, minRenterRating, true);
     
-    motorbikes.push_back(motorbike);
-    saveMotorbikes();
+    putMotorbike(motorbike);
+    if (!journalListing(motorbike)) {
+        return false;
+    }
     
-    cout << "Motorbike listed successfully!" << endl;
-    cout << "Motorbike ID: " << motorbikeId << endl;
+    messageStream() << "Motorbike listed successfully!" << endl;
+    messageStream() << "Motorbike ID: " << motorbikeId << endl;
     
     return true;
 }
 
 bool BookingManager::unlistMotorbike(const string& ownerUsername) {
-    for (Motorbike& motorbike : motorbikes) {
-        if (motorbike.getOwnerUsername() == ownerUsername && motorbike.getIsListed()) {
+    for (size_t slot = 0; slot < motorbikes.size(); slot++) {
+        if (motorbikes[slot].getOwnerUsername() == ownerUsername && motorbikes[slot].getIsListed()) {
             if (isMotorbikeBooked(ownerUsername)) {
-                cout << "Cannot unlist: motorbike has active bookings." << endl;
+                messageStream() << "Cannot unlist: motorbike has active bookings." << endl;
                 return false;
             }
             
+            Motorbike& motorbike = motorbikes.mutate(slot);
             motorbike.setIsListed(false);
-            saveMotorbikes();
-            cout << "Motorbike unlisted successfully." << endl;
+            syncCatalog(motorbike);
+            if (!journalListing(motorbike)) {
+                return false;
+            }
+            messageStream() << "Motorbike unlisted successfully." << endl;
             return true;
         }
     }
-    cout << "No listed motorbike found for this user." << endl;
+    messageStream() << "No listed motorbike found for this user." << endl;
     return false;
 }
 
@@ -551,39 +1291,35 @@ bool BookingManager::isMotorbikeListed(const string& ownerUsername) {
 }
 
 bool BookingManager::isMotorbikeBooked(const string& ownerUsername) {
-    for (const Booking& booking : bookings) {
-        if (booking.getOwnerUsername() == ownerUsername && booking.isApproved()) {
-            return true;
-        }
-    }
-    return false;
+    auto it = ownerActiveRentals.find(ownerUsername);
+    return it != ownerActiveRentals.end() && it->second > 0;
 }
 
 bool BookingManager::validateListingData(const string& location, const string& startDate,
                                         const string& endDate, double pricePerDay, double minRating) {
     if (location != "HCMC" && location != "Hanoi") {
-        cout << "Invalid location. Only HCMC and Hanoi are supported." << endl;
+        messageStream() << "Invalid location. Only HCMC and Hanoi are supported." << endl;
         return false;
     }
     
     if (pricePerDay <= 0) {
-        cout << "Price per day must be positive." << endl;
+        messageStream() << "Price per day must be positive." << endl;
         return false;
     }
     
     if (minRating < 0 || minRating > 5) {
-        cout << "Minimum renter rating must be between 0 and 5." << endl;
+        messageStream() << "Minimum renter rating must be between 0 and 5." << endl;
         return false;
     }
     
     // Parse dates for proper comparison (DD/MM/YYYY format)
     if (!isValidDate(startDate) || !isValidDate(endDate)) {
-        cout << "Invalid date format. Please use DD/MM/YYYY format." << endl;
+        messageStream() << "Invalid date format. Please use DD/MM/YYYY format." << endl;
         return false;
     }
     
     if (!isDateBefore(startDate, endDate)) {
-        cout << "Start date must be before end date." << endl;
+        messageStream() << "Start date must be before end date." << endl;
         return false;
     }
     
@@ -591,49 +1327,15 @@ bool BookingManager::validateListingData(const string& location, const string& s
 }
 
 bool BookingManager::isValidDate(const string& date) {
-    // Check if date is in DD/MM/YYYY format
-    if (date.length() != 10) return false;
-    if (date[2] != '/' || date[5] != '/') return false;
-    
-    // Extract day, month, year
-    string dayStr = date.substr(0, 2);
-    string monthStr = date.substr(3, 2);
-    string yearStr = date.substr(6, 4);
-    
-    try {
-        int day = stoi(dayStr);
-        int month = stoi(monthStr);
-        int year = stoi(yearStr);
-        
-        // Basic validation
-        if (day < 1 || day > 31) return false;
-        if (month < 1 || month > 12) return false;
-        if (year < 2020 || year > 2030) return false;
-        
-        return true;
-    } catch (...) {
-        return false;
-    }
+    // DD/MM/YYYY and a real calendar day within the supported years
+    Date parsed = Date::parse(date);
+    return parsed.isValid() && parsed.year() >= 2020 && parsed.year() <= 2030;
 }
 
 bool BookingManager::isDateBefore(const string& date1, const string& date2) {
-    // Parse dates (DD/MM/YYYY format)
-    int day1 = stoi(date1.substr(0, 2));
-    int month1 = stoi(date1.substr(3, 2));
-    int year1 = stoi(date1.substr(6, 4));
-    
-    int day2 = stoi(date2.substr(0, 2));
-    int month2 = stoi(date2.substr(3, 2));
-    int year2 = stoi(date2.substr(6, 4));
-    
-    // Compare dates
-    if (year1 < year2) return true;
-    if (year1 > year2) return false;
-    
-    if (month1 < month2) return true;
-    if (month1 > month2) return false;
-    
-    return day1 < day2;
+    Date first = Date::parse(date1);
+    Date second = Date::parse(date2);
+    return first.isValid() && second.isValid() && first < second;
 }
 
 double BookingManager::getUserRenterRating(const string& username) {
@@ -659,34 +1361,77 @@ double BookingManager::getUserMotorbikeRating(const string& username) {
 vector<Motorbike> BookingManager::searchMotorbikes(const string& searchDate, const string& city,
                                                   const string& username, Auth& auth) {
     vector<Motorbike> results;
-    for (const Motorbike& motorbike : motorbikes) {
-        if (meetsSearchCriteria(motorbike, searchDate, city, username, auth)) {
-            results.push_back(motorbike);
-        }
+    Date date = Date::parse(searchDate);
+    
+    // Same checks as meetsSearchCriteria, evaluated over the whole catalog at once
+    CatalogQuery query;
+    if (!makeSearchQuery(fieldPool().find(city), date, date, false, auth.getUserRenterRating(username),
+                         auth.getUserCreditPoints(username), query)) {
+        return results;
     }
+    
+    vector<uint64_t> selection;
+    results.reserve(selectMotorbikes(query, selection));
+    MotorbikeCatalog::forEachSelected(selection, [&](size_t slot) {
+        results.push_back(motorbikes[slot]);
+    });
     return results;
 }
 
 vector<Motorbike> BookingManager::searchMotorbikesByDateRange(const string& startDate, const string& endDate,
                                                              const string& city, const string& username, Auth& auth) {
     vector<Motorbike> results;
-    for (const Motorbike& motorbike : motorbikes) {
-        if (meetsDateRangeSearchCriteria(motorbike, startDate, endDate, city, username, auth)) {
-            results.push_back(motorbike);
-        }
+    
+    // Same checks as meetsDateRangeSearchCriteria, including approved-booking
+    // overlaps via the catalog's day-occupancy bitmaps
+    CatalogQuery query;
+    if (!makeSearchQuery(fieldPool().find(city), Date::parse(startDate), Date::parse(endDate), true,
+                         auth.getUserRenterRating(username), auth.getUserCreditPoints(username), query)) {
+        return results;
     }
+    
+    vector<uint64_t> selection;
+    results.reserve(selectMotorbikes(query, selection));
+    MotorbikeCatalog::forEachSelected(selection, [&](size_t slot) {
+        results.push_back(motorbikes[slot]);
+    });
     return results;
 }
 
+// Same filters as searchMotorbikes / searchMotorbikesByDateRange, but only
+// the requested page is ranked and copied (rankSearchPage)
+SearchPage BookingManager::searchMotorbikesPage(const SearchRequest& request, const string& username, Auth& auth) {
+    SearchPage page;
+    bool dateRange = !request.endDate.empty();
+    Date start = Date::parse(request.startDate);
+    Date end = dateRange ? Date::parse(request.endDate) : start;
+    CatalogQuery query;
+    if (!makeSearchQuery(fieldPool().find(request.city), start, end, dateRange, auth.getUserRenterRating(username),
+                         auth.getUserCreditPoints(username), query)) {
+        return page;
+    }
+    
+    vector<uint64_t> selection;
+    page.totalMatches = selectMotorbikes(query, selection);
+    rankSearchPage(request, query, motorbikes, selection, page);
+    return page;
+}
+
 bool BookingManager::meetsSearchCriteria(const Motorbike& motorbike, const string& searchDate,
                                         const string& city, const string& username, Auth& auth) {
+    return meetsSearchCriteria(motorbike, Date::parse(searchDate), fieldPool().find(city),
+                               auth.getUserRenterRating(username), auth.getUserCreditPoints(username));
+}
+
+bool BookingManager::meetsSearchCriteria(const Motorbike& motorbike, Date searchDate, uint32_t cityId,
+                                        double renterRating, double renterCredits) {
     // Check if motorbike is listed and available
     if (!motorbike.getIsListed() || !motorbike.getIsAvailable()) {
         return false;
     }
     
     // Check location
-    if (motorbike.getLocation() != city) {
+    if (motorbike.getLocationId() != cityId) {
         return false;
     }
     
@@ -696,15 +1441,13 @@ bool BookingManager::meetsSearchCriteria(const Motorbike& motorbike, const strin
     }
     
     // Check renter rating requirement
-    double renterRating = auth.getUserRenterRating(username);
     if (renterRating < motorbike.getMinRenterRating()) {
         return false;
     }
     
     // Check credit points
     double totalCost = calculateTotalCost(motorbike, searchDate, searchDate);
-    double userCPs = auth.getUserCreditPoints(username);
-    if (userCPs < totalCost) {
+    if (renterCredits < totalCost) {
         return false;
     }
     
@@ -717,18 +1460,24 @@ bool BookingManager::meetsSearchCriteria(const Motorbike& motorbike, const strin
 bool BookingManager::meetsDateRangeSearchCriteria(const Motorbike& motorbike, const string& startDate,
                                                  const string& endDate, const string& city,
                                                  const string& username, Auth& auth) {
+    return meetsDateRangeSearchCriteria(motorbike, Date::parse(startDate), Date::parse(endDate), fieldPool().find(city),
+                                        auth.getUserRenterRating(username), auth.getUserCreditPoints(username));
+}
+
+bool BookingManager::meetsDateRangeSearchCriteria(const Motorbike& motorbike, Date startDate, Date endDate,
+                                                 uint32_t cityId, double renterRating, double renterCredits) {
     // Check if motorbike is listed and available
     if (!motorbike.getIsListed() || !motorbike.getIsAvailable()) {
         return false;
     }
     
     // Check location
-    if (motorbike.getLocation() != city) {
+    if (motorbike.getLocationId() != cityId) {
         return false;
     }
     
     // Check if the entire date range is within motorbike's available period
-    if (!motorbike.isAvailableForDateRange(startDate, endDate)) {
+    if (endDate < startDate || !motorbike.isAvailableForDateRange(startDate, endDate)) {
         return false;
     }
     
@@ -738,15 +1487,13 @@ bool BookingManager::meetsDateRangeSearchCriteria(const Motorbike& motorbike, co
     }
     
     // Check renter rating requirement
-    double renterRating = auth.getUserRenterRating(username);
     if (renterRating < motorbike.getMinRenterRating()) {
         return false;
     }
     
     // Check credit points
     double totalCost = calculateTotalCost(motorbike, startDate, endDate);
-    double userCPs = auth.getUserCreditPoints(username);
-    if (userCPs < totalCost) {
+    if (renterCredits < totalCost) {
         return false;
     }
     
@@ -757,14 +1504,20 @@ bool BookingManager::meetsDateRangeSearchCriteria(const Motorbike& motorbike, co
 }
 
 bool BookingManager::isDateInRange(const string& searchDate, const string& startDate, const string& endDate) {
-    return searchDate >= startDate && searchDate <= endDate;
+    Date date = Date::parse(searchDate);
+    return date.isValid() && date >= Date::parse(startDate) && date <= Date::parse(endDate);
 }
 
 double BookingManager::calculateTotalCost(const Motorbike& motorbike, const string& startDate, const string& endDate) {
-    (void)startDate; // Suppress unused parameter warning
-    (void)endDate;   // Suppress unused parameter warning
-    // Simple calculation - in real app, would calculate actual days
-    int days = 1; // Default to 1 day
+    return calculateTotalCost(motorbike, Date::parse(startDate), Date::parse(endDate));
+}
+
+double BookingManager::calculateTotalCost(const Motorbike& motorbike, Date startDate, Date endDate) {
+    // Both ends of the period count as rental days
+    int days = 1;
+    if (startDate.isValid() && endDate.isValid() && endDate > startDate) {
+        days = endDate - startDate + 1;
+    }
     return motorbike.calculateRentalCost(days);
 }
 
@@ -787,131 +1540,173 @@ bool BookingManager::hasValidLicense(const string& username, Auth& auth, int eng
         return true; // No license required for 50cc and below
     }
     
-    // Get current user and check license validity
-    User* currentUser = auth.getCurrentUser();
-    if (!currentUser || currentUser->getUsername() != username) {
-        // Try to find user in auth system
-        vector<User> allUsers = auth.getAllUsers();
-        for (const User& user : allUsers) {
-            if (user.getUsername() == username) {
-                return user.hasValidLicense();
-            }
-        }
-        return false;
+    const User* user = auth.getUser(username);
+    return user && user->hasValidLicense();
+}
+
+// Listed motorbikes whose brand, model, description or reviews mention the
+// keywords, best match first
+vector<Motorbike> BookingManager::searchMotorbikesByKeyword(const string& keywords, size_t limit) {
+    auto listed = [this](uint32_t slot) { return motorbikes[slot].getIsListed(); };
+    vector<Motorbike> results;
+    for (const TextIndex::Match& match : textIndex.search(keywords, limit, listed)) {
+        results.push_back(motorbikes[match.document]);
     }
-    
-    return currentUser->hasValidLicense();
+    return results;
 }
 
 vector<string> BookingManager::getMotorbikeReviews(const string& motorbikeId) {
     vector<string> motorbikeComments;
+    auto it = reviewStats.find(motorbikeId);
+    if (it == reviewStats.end()) {
+        return motorbikeComments;
+    }
     
-    for (const Review& review : reviews) {
-        if (review.getMotorbikeId() == motorbikeId) {
-            string reviewText = "Rating: " + to_string(review.getRating()) + "/5.0 - " + 
-                               review.getComment() + " (by " + review.getRenterUsername() + 
-                               " on " + review.getReviewDate() + ")";
-            motorbikeComments.push_back(reviewText);
-        }
+    motorbikeComments.reserve(it->second.slots.size());
+    for (size_t slot : it->second.slots) {
+        const Review& review = reviews[slot];
+        string reviewText = "Rating: " + to_string(review.getRating()) + "/5.0 - " + 
+                           review.getComment() + " (by " + review.getRenterUsername() + 
+                           " on " + review.getReviewDate() + ")";
+        motorbikeComments.push_back(reviewText);
     }
     
     return motorbikeComments;
 }
 
 double BookingManager::getAverageRating(const string& motorbikeId) {
-    double totalRating = 0.0;
-    int count = 0;
-    
-    for (const Review& review : reviews) {
-        if (review.getMotorbikeId() == motorbikeId) {
-            totalRating += review.getRating();
-            count++;
-        }
-    }
-    
-    if (count > 0) {
-        return totalRating / count;
+    auto it = reviewStats.find(motorbikeId);
+    if (it != reviewStats.end() && it->second.count > 0) {
+        return it->second.ratingSum / it->second.count;
     }
     
     // Fallback to motorbike's stored rating if no reviews
-    Motorbike* motorbike = getMotorbikeById(motorbikeId);
+    const Motorbike* motorbike = getMotorbikeById(motorbikeId);
     return motorbike ? motorbike->getRating() : 0.0;
 }
 
-bool BookingManager::hasActiveRental(const string& username) {
-    for (const Booking& booking : bookings) {
-        if (booking.getRenterUsername() == username && booking.isApproved()) {
-            return true;
-        }
+int BookingManager::getReviewCount(const string& motorbikeId) {
+    auto it = reviewStats.find(motorbikeId);
+    return it != reviewStats.end() ? it->second.count : 0;
+}
+
+vector<int> BookingManager::getRatingDistribution(const string& motorbikeId) {
+    auto it = reviewStats.find(motorbikeId);
+    if (it == reviewStats.end()) {
+        return vector<int>(5, 0);
     }
-    return false;
+    return vector<int>(it->second.histogram, it->second.histogram + 5);
+}
+
+bool BookingManager::hasActiveRental(const string& username) {
+    auto it = renterActiveRentals.find(username);
+    return it != renterActiveRentals.end() && it->second > 0;
 }
 
 bool BookingManager::hasOverlappingApprovedBookings(const string& motorbikeId, const string& startDate, const string& endDate) {
-    for (const Booking& booking : bookings) {
-        if (booking.getMotorbikeId() == motorbikeId && booking.isApproved()) {
-            // Simple overlap check - in real app, would use proper date comparison
-            if (booking.getStartDate() <= endDate && booking.getEndDate() >= startDate) {
-                return true;
-            }
-        }
-    }
-    return false;
+    return hasOverlappingApprovedBookings(motorbikeId, Date::parse(startDate), Date::parse(endDate));
+}
+
+bool BookingManager::hasOverlappingApprovedBookings(const string& motorbikeId, Date startDate, Date endDate) {
+    auto it = schedules.find(motorbikeId);
+    return it != schedules.end() && it->second.approved.overlaps(startDate, endDate);
 }
 
 void BookingManager::rejectOverlappingRequests(const string& motorbikeId, const string& startDate,
                                               const string& endDate, const string& approvedBookingId) {
-    for (Booking& booking : bookings) {
-        if (booking.getMotorbikeId() == motorbikeId && booking.getBookingId() != approvedBookingId && booking.isPending()) {
-            // Simple overlap check
-            if (booking.getStartDate() <= endDate && booking.getEndDate() >= startDate) {
-                booking.setStatus("Rejected");
-            }
+    string records;
+    int count = rejectOverlappingRequests(motorbikeId, Date::parse(startDate), Date::parse(endDate),
+                                          approvedBookingId, records);
+    if (count > 0) {
+        publishSnapshot();
+        commitJournal(queueJournal(records, count));
+    }
+}
+
+// Appends the journal records of the rejections to records and returns how many
+int BookingManager::rejectOverlappingRequests(const string& motorbikeId, Date startDate, Date endDate,
+                                             const string& approvedBookingId, string& records) {
+    auto it = schedules.find(motorbikeId);
+    if (it == schedules.end()) {
+        return 0;
+    }
+    
+    // Collect first - rejecting a request removes it from the tree being walked
+    vector<size_t> overlapping;
+    it->second.pending.forEachOverlap(startDate, endDate, [&](Date, Date, size_t slot) {
+        if (bookings[slot].getBookingId() != approvedBookingId) {
+            overlapping.push_back(slot);
         }
+    });
+    
+    for (size_t slot : overlapping) {
+        transitionBooking(bookings.mutate(slot), BookingStatus::Rejected);
+        records += statusRecord(bookings[slot]);
     }
+    return static_cast<int>(overlapping.size());
 }
 
 bool BookingManager::completeRental(const string& bookingId, const string& renterUsername) {
-    for (Booking& booking : bookings) {
-        if (booking.getBookingId() == bookingId && booking.getRenterUsername() == renterUsername && booking.isApproved()) {
-            booking.setStatus("Completed");
-            
-            // Make motorbike available again
-            Motorbike* motorbike = getMotorbikeById(booking.getMotorbikeId());
-            if (motorbike) {
-                motorbike->setIsAvailable(true);
-            }
-            
-            saveBookings();
-            saveMotorbikes();
-            
-            cout << "Rental completed successfully!" << endl;
-            return true;
-        }
+    string motorbikeId;
+    if (!findBookingMotorbike(bookingId, motorbikeId)) {
+        return false;
     }
-    return false;
+    unique_lock<mutex> motorbikeLock = writerLock(motorbikeLocks[motorbikeStripe(motorbikeId)]);
+    unique_lock<mutex> state = writerLock(stateMutex);
+    Booking* booking = findBooking(bookingId);
+    if (booking->getRenterUsername() != renterUsername || !booking->isApproved()) {
+        return false;
+    }
+    transitionBooking(*booking, BookingStatus::Completed);
+    string records = statusRecord(*booking);
+    int count = 1;
+    
+    // Make motorbike available again
+    Motorbike* motorbike = findMotorbike(motorbikeId);
+    if (motorbike) {
+        motorbike->setIsAvailable(true);
+        syncCatalog(*motorbike);
+        records += availabilityRecord(*motorbike);
+        count++;
+    }
+    publishSnapshot();
+    uint64_t sequence = queueJournal(records, count);
+    release(state);
+    release(motorbikeLock);
+    if (!commitJournal(sequence)) {
+        return false;
+    }
+    
+    messageStream() << "Rental completed successfully!" << endl;
+    return true;
 }
 
 bool BookingManager::rateMotorbike(const string& bookingId, const string& renterUsername, double rating, const string& comment) {
-    for (Booking& booking : bookings) {
-        if (booking.getBookingId() == bookingId && booking.getRenterUsername() == renterUsername && booking.isCompleted()) {
+    // Read through the const accessor: findBooking would clone the booking's
+    // page and force a republish for a record this never changes
+    auto found = bookingIndex.find(bookingId);
+    if (found != bookingIndex.end()) {
+        const Booking& booking = bookings[found->second];
+        if (booking.getRenterUsername() == renterUsername && booking.isCompleted()) {
             // Add review using the new function
             if (!addReview(booking.getMotorbikeId(), renterUsername, rating, comment)) {
                 return false;
             }
             
-            // Update motorbike rating based on all reviews
+            // Update motorbike rating from the running review aggregates
             double newAverageRating = getAverageRating(booking.getMotorbikeId());
-            Motorbike* motorbike = getMotorbikeById(booking.getMotorbikeId());
+            Motorbike* motorbike = findMotorbike(booking.getMotorbikeId());
             if (motorbike) {
                 motorbike->setRating(newAverageRating);
-                saveMotorbikes();
+                if (!journalListing(*motorbike)) {
+                    return false;
+                }
             }
             
-            cout << "Motorbike rated successfully!" << endl;
-            cout << "Rating: " << rating << "/5.0" << endl;
-            cout << "Comment: " << comment << endl;
-            cout << "New average rating: " << newAverageRating << "/5.0" << endl;
+            messageStream() << "Motorbike rated successfully!" << endl;
+            messageStream() << "Rating: " << rating << "/5.0" << endl;
+            messageStream() << "Comment: " << comment << endl;
+            messageStream() << "New average rating: " << newAverageRating << "/5.0" << endl;
             
             return true;
         }
@@ -920,11 +1715,13 @@ bool BookingManager::rateMotorbike(const string& bookingId, const string& renter
 }
 
 bool BookingManager::rateRenter(const string& bookingId, const string& ownerUsername, double rating, const string& comment) {
-    for (Booking& booking : bookings) {
-        if (booking.getBookingId() == bookingId && booking.getOwnerUsername() == ownerUsername && booking.isCompleted()) {
-            cout << "Renter rated successfully!" << endl;
-            cout << "Rating: " << rating << "/5.0" << endl;
-            cout << "Comment: " << comment << endl;
+    auto found = bookingIndex.find(bookingId);
+    if (found != bookingIndex.end()) {
+        const Booking& booking = bookings[found->second];
+        if (booking.getOwnerUsername() == ownerUsername && booking.isCompleted()) {
+            messageStream() << "Renter rated successfully!" << endl;
+            messageStream() << "Rating: " << rating << "/5.0" << endl;
+            messageStream() << "Comment: " << comment << endl;
             
             // In a real app, this would update the renter's rating in the Auth system
             return true;
@@ -939,51 +1736,56 @@ string BookingManager::generateReviewId() {
 
 bool BookingManager::addReview(const string& motorbikeId, const string& renterUsername, double rating, const string& comment) {
     if (rating < 1.0 || rating > 5.0) {
-        cout << "Rating must be between 1.0 and 5.0." << endl;
+        messageStream() << "Rating must be between 1.0 and 5.0." << endl;
         return false;
     }
     
     string reviewId = generateReviewId();
     string reviewDate = "25/09/2025"; // Current date - in real app would use actual date
     
-    Review newReview(reviewId, motorbikeId, renterUsername, rating, comment, reviewDate);
-    reviews.push_back(newReview);
+    putReview(Review(reviewId, motorbikeId, renterUsername, rating, comment, reviewDate));
     saveReviews();
     
-    cout << "Review added successfully!" << endl;
+    messageStream() << "Review added successfully!" << endl;
     return true;
 }
 
+void BookingManager::putReview(Review newReview) {
+    const Review& review = reviews.emplace_back(move(newReview));
+    ReviewStats& stats = reviewStats[review.getMotorbikeId()];
+    stats.ratingSum += review.getRating();
+    stats.count++;
+    long star = lround(review.getRating());
+    stats.histogram[min(max(star, 1L), 5L) - 1]++;
+    stats.slots.push_back(reviews.size() - 1);
+    
+    auto it = motorbikeIndex.find(review.getMotorbikeId());
+    if (it != motorbikeIndex.end()) {
+        textIndex.add(static_cast<uint32_t>(it->second), review.getComment());
+    }
+}
+
 void BookingManager::loadReviews() {
-    ifstream file(reviewFilename);
-    if (!file.is_open()) {
+    MappedFile file(reviewFilename);
+    if (!file.isOpen()) {
         return;
     }
     
-    string line;
-    while (getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        
-        stringstream ss(line);
-        string token;
-        vector<string> tokens;
-        
-        while (getline(ss, token, '|')) {
-            tokens.push_back(token);
+    reviews.reserve(countLines(file.view()));
+    forEachRecord(file.view(), [this](const string_view* fields, size_t count) {
+        if (count >= 6) {
+            putReview(reviewFromFields(fields));
         }
-        
-        if (tokens.size() >= 6) {
-            Review review(tokens[0], tokens[1], tokens[2], stod(tokens[3]), tokens[4], tokens[5]);
-            reviews.push_back(review);
-        }
-    }
-    file.close();
+    });
 }
 
 void BookingManager::saveReviews() {
+    if (!dataLock.isHeld()) {
+        return;
+    }
     ofstream file(reviewFilename);
     if (!file.is_open()) {
-        cout << "Error: Cannot save reviews to file." << endl;
+        messageStream() << "Error: Cannot save reviews to file." << endl;
         return;
     }
     
@@ -0,0 +1,263 @@
+#include "booking_server.h"
+
+#ifdef __linux__
+#include "auth.h"
+#include <algorithm>
+
+using namespace std;
+
+// ============================================================================
+// BOOKING SERVER IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+const uint32_t MAX_SEARCH_LIMIT = 100;
+
+void writeBooking(FrameWriter& response, const Booking& booking) {
+    response.str(booking.getBookingId())
+            .str(booking.getRenterUsername())
+            .str(booking.getMotorbikeId())
+            .str(booking.getStartDate())
+            .str(booking.getEndDate())
+            .f64(booking.getTotalCost())
+            .str(booking.getStatus());
+}
+
+} // namespace
+
+BookingServer::BookingServer(EventLoop& loop, Auth& auth, BookingManager& bookingManager)
+    : SocketServer(loop), auth(auth), bookingManager(bookingManager) {
+}
+
+// Handles every complete frame while the output backlog allows it
+size_t BookingServer::handleInput(Connection& connection) {
+    size_t consumed = 0;
+    while (!backlogFull(connection)) {
+        size_t available = connection.input.size() - consumed;
+        if (available < FRAME_HEADER_SIZE) {
+            break;
+        }
+        uint32_t length = frameLength(connection.input.data() + consumed, available);
+        if (length == 0 || length > MAX_FRAME_SIZE) {
+            // Not a client of this protocol; drop what it sent and hang up
+            connection.closing = true;
+            return connection.input.size();
+        }
+        if (available - FRAME_HEADER_SIZE < length) {
+            break;
+        }
+        handleRequest(connection, string_view(connection.input.data() + consumed + FRAME_HEADER_SIZE, length));
+        consumed += FRAME_HEADER_SIZE + length;
+    }
+    return consumed;
+}
+
+// ============================================================================
+// REQUEST HANDLING
+// ============================================================================
+
+void BookingServer::handleRequest(Connection& connection, string_view payload) {
+    beginRequest();
+
+    FrameReader request(payload);
+    Opcode opcode = static_cast<Opcode>(request.u8());
+    if (opcode != Opcode::Login && connection.username.empty()) {
+        replyStatus(connection, ResponseStatus::NotLoggedIn);
+        return;
+    }
+    switch (opcode) {
+        case Opcode::Login:
+            handleLogin(connection, request);
+            break;
+        case Opcode::Logout:
+            if (endOfRequest(connection, request)) {
+                connection.username.clear();
+                replyStatus(connection, ResponseStatus::Ok);
+            }
+            break;
+        case Opcode::Search:
+            handleSearch(connection, request);
+            break;
+        case Opcode::Book:
+            handleBook(connection, request);
+            break;
+        case Opcode::Requests:
+            handleBookingList(connection, request, true);
+            break;
+        case Opcode::Bookings:
+            handleBookingList(connection, request, false);
+            break;
+        case Opcode::Approve:
+            handleDecision(connection, request, true);
+            break;
+        case Opcode::Reject:
+            handleDecision(connection, request, false);
+            break;
+        case Opcode::Profile:
+            handleProfile(connection, request);
+            break;
+        default:
+            replyStatus(connection, ResponseStatus::BadRequest);
+    }
+}
+
+void BookingServer::handleLogin(Connection& connection, FrameReader& request) {
+    string username(request.str());
+    string password(request.str());
+    if (!endOfRequest(connection, request)) {
+        return;
+    }
+    const User* user = auth.checkCredentials(username, password, "member");
+    if (!user) {
+        replyError(connection, BookingError::None, "Invalid username or password.");
+        return;
+    }
+    connection.username = username;
+    FrameWriter(connection.output).u8(static_cast<uint8_t>(ResponseStatus::Ok))
+        .str(user->getFullName())
+        .f64(user->getCreditPoints())
+        .f64(user->getRating())
+        .finish();
+}
+
+void BookingServer::handleSearch(Connection& connection, FrameReader& request) {
+    SearchRequest search;
+    search.startDate = string(request.str());
+    search.endDate = string(request.str());
+    search.city = string(request.str());
+    uint8_t sortKey = request.u8();
+    search.limit = min(request.u32(), MAX_SEARCH_LIMIT);
+    search.after.valid = request.u8() != 0;
+    search.after.key = request.f64();
+    search.after.slot = request.u32();
+    if (sortKey > static_cast<uint8_t>(SearchSortKey::TotalCost)) {
+        replyStatus(connection, ResponseStatus::BadRequest);
+        return;
+    }
+    if (!endOfRequest(connection, request)) {
+        return;
+    }
+    search.sortKey = static_cast<SearchSortKey>(sortKey);
+
+    SearchPage page = bookingManager.searchMotorbikesPage(search, connection.username, auth);
+    FrameWriter response(connection.output);
+    response.u8(static_cast<uint8_t>(ResponseStatus::Ok))
+            .u32(static_cast<uint32_t>(page.totalMatches))
+            .u8(page.hasMore)
+            .u8(page.next.valid)
+            .f64(page.next.key)
+            .u32(static_cast<uint32_t>(page.next.slot))
+            .u32(static_cast<uint32_t>(page.results.size()));
+    for (const Motorbike& motorbike : page.results) {
+        response.str(motorbike.getMotorbikeId())
+                .str(motorbike.getBrand())
+                .str(motorbike.getModel())
+                .str(motorbike.getColor())
+                .str(motorbike.getSize())
+                .str(motorbike.getLocation())
+                .f64(motorbike.getPricePerDay())
+                .f64(motorbike.getRating());
+    }
+    response.finish();
+}
+
+void BookingServer::handleBook(Connection& connection, FrameReader& request) {
+    vector<BookingRequest> batch(1);
+    batch[0].renter = connection.username;
+    batch[0].motorbikeId = string(request.str());
+    batch[0].startDate = string(request.str());
+    batch[0].endDate = string(request.str());
+    if (!endOfRequest(connection, request)) {
+        return;
+    }
+    BookingResult result = bookingManager.createBookings(batch, auth)[0];
+    if (!result.created()) {
+        replyError(connection, result.error, bookingErrorMessage(result.error));
+        return;
+    }
+    FrameWriter(connection.output).u8(static_cast<uint8_t>(ResponseStatus::Ok))
+        .str(result.bookingId)
+        .f64(result.totalCost)
+        .finish();
+}
+
+// Pending requests on the user's motorbikes, or the user's own bookings
+void BookingServer::handleBookingList(Connection& connection, FrameReader& request, bool rentalRequests) {
+    if (!endOfRequest(connection, request)) {
+        return;
+    }
+    bookingScratch.clear();
+    auto collect = [&](const Booking& booking) { bookingScratch.push_back(&booking); };
+    if (rentalRequests) {
+        bookingManager.forEachRentalRequest(connection.username, collect);
+    } else {
+        bookingManager.forEachUserBooking(connection.username, collect);
+    }
+    FrameWriter response(connection.output);
+    response.u8(static_cast<uint8_t>(ResponseStatus::Ok)).u32(static_cast<uint32_t>(bookingScratch.size()));
+    for (const Booking* booking : bookingScratch) {
+        writeBooking(response, *booking);
+    }
+    response.finish();
+}
+
+void BookingServer::handleDecision(Connection& connection, FrameReader& request, bool approve) {
+    string bookingId(request.str());
+    if (!endOfRequest(connection, request)) {
+        return;
+    }
+    bool done = approve ? bookingManager.approveBooking(bookingId, connection.username, auth)
+                        : bookingManager.rejectBooking(bookingId, connection.username);
+    if (!done) {
+        replyError(connection, BookingError::None, "No pending request " + bookingId + " on your motorbike.");
+        return;
+    }
+    replyStatus(connection, ResponseStatus::Ok);
+}
+
+void BookingServer::handleProfile(Connection& connection, FrameReader& request) {
+    if (!endOfRequest(connection, request)) {
+        return;
+    }
+    const User* user = auth.getUser(connection.username);
+    if (!user) {
+        replyError(connection, BookingError::None, "Account no longer exists.");
+        return;
+    }
+    FrameWriter(connection.output).u8(static_cast<uint8_t>(ResponseStatus::Ok))
+        .str(user->getUsername())
+        .str(user->getFullName())
+        .str(user->getEmail())
+        .str(user->getPhoneNumber())
+        .str(user->getIdType())
+        .str(user->getLicenseNumber())
+        .str(user->getLicenseExpiry())
+        .f64(user->getCreditPoints())
+        .f64(user->getRating())
+        .finish();
+}
+
+// Replies BadRequest unless the request was read exactly to its end
+bool BookingServer::endOfRequest(Connection& connection, FrameReader& request) {
+    if (!request.isValid() || !request.atEnd()) {
+        replyStatus(connection, ResponseStatus::BadRequest);
+        return false;
+    }
+    return true;
+}
+
+void BookingServer::replyStatus(Connection& connection, ResponseStatus status) {
+    FrameWriter(connection.output).u8(static_cast<uint8_t>(status)).finish();
+}
+
+// The engine's own explanation when it printed one, otherwise fallback
+void BookingServer::replyError(Connection& connection, BookingError error, const string& fallback) {
+    string message = lastMessage();
+    FrameWriter(connection.output).u8(static_cast<uint8_t>(ResponseStatus::Error))
+        .u8(static_cast<uint8_t>(error))
+        .str(message.empty() ? fallback : message)
+        .finish();
+}
+
+#endif
@@ -0,0 +1,165 @@
+#include "booking_snapshot.h"
+#include <algorithm>
+
+using namespace std;
+
+// ============================================================================
+// SHARED SEARCH STEPS
+// ============================================================================
+
+bool makeSearchQuery(uint32_t cityId, Date start, Date end, bool requireFree,
+                     double renterRating, double renterCredits, CatalogQuery& query) {
+    if (cityId == StringPool::NOT_FOUND || !start.isValid() || !end.isValid() || end < start) {
+        return false;   // No motorbike was ever listed there, or no such period
+    }
+    query.cityId = cityId;
+    query.startDay = start.dayNumber();
+    query.endDay = end.dayNumber();
+    query.rentalDays = end - start + 1;
+    query.renterRating = renterRating;
+    query.renterCredits = renterCredits;
+    query.requireFree = requireFree;
+    return true;
+}
+
+void rankSearchPage(const SearchRequest& request, const CatalogQuery& query,
+                    const CowTable<Motorbike>& motorbikes, const vector<uint64_t>& selection,
+                    SearchPage& page) {
+    if (request.limit == 0) {
+        page.hasMore = page.totalMatches > 0;
+        page.next = request.after;
+        return;
+    }
+
+    // Every order is expressed as ascending (key, slot)
+    auto keyOf = [&](size_t slot) {
+        const Motorbike& motorbike = motorbikes[slot];
+        switch (request.sortKey) {
+            case SearchSortKey::Rating:
+                return -motorbike.getRating();
+            case SearchSortKey::TotalCost:
+                return motorbike.calculateRentalCost(static_cast<int>(query.rentalDays));
+            default:
+                return motorbike.getPricePerDay();
+        }
+    };
+
+    typedef pair<double, size_t> Entry;
+    Entry cursor(request.after.key, request.after.slot);
+    vector<Entry> heap;
+    heap.reserve(request.limit);
+    size_t remaining = 0;
+    MotorbikeCatalog::forEachSelected(selection, [&](size_t slot) {
+        Entry entry(keyOf(slot), slot);
+        if (request.after.valid && !(cursor < entry)) {
+            return;
+        }
+        remaining++;
+        if (heap.size() < request.limit) {
+            heap.push_back(entry);
+            push_heap(heap.begin(), heap.end());
+        } else if (entry < heap.front()) {
+            pop_heap(heap.begin(), heap.end());
+            heap.back() = entry;
+            push_heap(heap.begin(), heap.end());
+        }
+    });
+    sort_heap(heap.begin(), heap.end());
+
+    page.results.reserve(heap.size());
+    for (const Entry& entry : heap) {
+        page.results.push_back(motorbikes[entry.second]);
+    }
+    page.hasMore = remaining > heap.size();
+    page.next = request.after;
+    if (!heap.empty()) {
+        page.next.key = heap.back().first;
+        page.next.slot = heap.back().second;
+        page.next.valid = true;
+    }
+}
+
+// ============================================================================
+// BOOKING SNAPSHOT IMPLEMENTATION
+// ============================================================================
+
+BookingSnapshot::BookingSnapshot(const CowTable<Motorbike>& motorbikes, const CowTable<Booking>& bookings,
+                                 const MotorbikeCatalog& catalog, const CowIndex<vector<size_t>>& renterBookings,
+                                 const CowIndex<set<size_t>>& ownerRequests, const vector<uint32_t>& locations,
+                                 uint64_t version)
+    : motorbikes(motorbikes), bookings(bookings), catalog(catalog), renterBookings(renterBookings),
+      ownerRequests(ownerRequests), locations(locations), version(version) {
+}
+
+uint32_t BookingSnapshot::findCity(const string& city) const {
+    for (uint32_t location : locations) {
+        if (fieldPool().str(location) == city) {
+            return location;
+        }
+    }
+    return StringPool::NOT_FOUND;
+}
+
+vector<Motorbike> BookingSnapshot::collect(const CatalogQuery& query) const {
+    vector<uint64_t> selection;
+    vector<Motorbike> results;
+    results.reserve(catalog.select(query, selection));
+    MotorbikeCatalog::forEachSelected(selection, [&](size_t slot) {
+        results.push_back(motorbikes[slot]);
+    });
+    return results;
+}
+
+vector<Motorbike> BookingSnapshot::searchMotorbikes(const string& searchDate, const string& city,
+                                                    double renterRating, double renterCredits) const {
+    Date date = Date::parse(searchDate);
+    CatalogQuery query;
+    if (!makeSearchQuery(findCity(city), date, date, false, renterRating, renterCredits, query)) {
+        return vector<Motorbike>();
+    }
+    return collect(query);
+}
+
+vector<Motorbike> BookingSnapshot::searchMotorbikesByDateRange(const string& startDate, const string& endDate,
+                                                               const string& city, double renterRating,
+                                                               double renterCredits) const {
+    CatalogQuery query;
+    if (!makeSearchQuery(findCity(city), Date::parse(startDate), Date::parse(endDate), true,
+                         renterRating, renterCredits, query)) {
+        return vector<Motorbike>();
+    }
+    return collect(query);
+}
+
+SearchPage BookingSnapshot::searchMotorbikesPage(const SearchRequest& request, double renterRating,
+                                                 double renterCredits) const {
+    SearchPage page;
+    bool dateRange = !request.endDate.empty();
+    Date start = Date::parse(request.startDate);
+    Date end = dateRange ? Date::parse(request.endDate) : start;
+    CatalogQuery query;
+    if (!makeSearchQuery(findCity(request.city), start, end, dateRange, renterRating, renterCredits, query)) {
+        return page;
+    }
+
+    vector<uint64_t> selection;
+    page.totalMatches = catalog.select(query, selection);
+    rankSearchPage(request, query, motorbikes, selection, page);
+    return page;
+}
+
+vector<Booking> BookingSnapshot::getUserBookings(const string& username) const {
+    vector<Booking> userBookings;
+    forEachUserBooking(username, [&](const Booking& booking) {
+        userBookings.push_back(booking);
+    });
+    return userBookings;
+}
+
+vector<Booking> BookingSnapshot::getUserRentalRequests(const string& username) const {
+    vector<Booking> requests;
+    forEachRentalRequest(username, [&](const Booking& booking) {
+        requests.push_back(booking);
+    });
+    return requests;
+}
@@ -0,0 +1,209 @@
+#include "command_queue.h"
+#include "auth.h"
+#include "message_stream.h"
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+// ============================================================================
+// BOOKING COMMANDS
+// ============================================================================
+
+BookingCommand BookingCommand::createBooking(const string& renter, const string& motorbikeId,
+                                             const string& startDate, const string& endDate) {
+    BookingCommand command;
+    command.type = CommandType::CreateBooking;
+    command.username = renter;
+    command.target = motorbikeId;
+    command.startDate = startDate;
+    command.endDate = endDate;
+    return command;
+}
+
+BookingCommand BookingCommand::approveBooking(const string& bookingId, const string& owner) {
+    BookingCommand command;
+    command.type = CommandType::ApproveBooking;
+    command.username = owner;
+    command.target = bookingId;
+    return command;
+}
+
+BookingCommand BookingCommand::rejectBooking(const string& bookingId, const string& owner) {
+    BookingCommand command;
+    command.type = CommandType::RejectBooking;
+    command.username = owner;
+    command.target = bookingId;
+    return command;
+}
+
+BookingCommand BookingCommand::completeRental(const string& bookingId, const string& renter) {
+    BookingCommand command;
+    command.type = CommandType::CompleteRental;
+    command.username = renter;
+    command.target = bookingId;
+    return command;
+}
+
+BookingCommand BookingCommand::listMotorbike(const string& owner, const MotorbikeListing& listing) {
+    BookingCommand command;
+    command.type = CommandType::ListMotorbike;
+    command.username = owner;
+    command.listing = make_shared<const MotorbikeListing>(listing);
+    return command;
+}
+
+BookingCommand BookingCommand::topUpCredits(const string& username, double amount) {
+    BookingCommand command;
+    command.type = CommandType::TopUpCredits;
+    command.username = username;
+    command.amount = amount;
+    return command;
+}
+
+BookingCommand BookingCommand::deductCredits(const string& username, double amount) {
+    BookingCommand command;
+    command.type = CommandType::DeductCredits;
+    command.username = username;
+    command.amount = amount;
+    return command;
+}
+
+// ============================================================================
+// COMMAND QUEUE IMPLEMENTATION
+// ============================================================================
+
+CommandQueue::CommandQueue(BookingManager& bookingManager, Auth& auth, size_t capacity)
+    : bookingManager(bookingManager), auth(auth), ring(capacity), applied(0), sleeping(false),
+      stopping(false), commandCount(0), batchCount(0), applier(&CommandQueue::run, this) {
+}
+
+CommandQueue::~CommandQueue() {
+    {
+        lock_guard<mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    applier.join();
+}
+
+future<CommandResult> CommandQueue::submit(BookingCommand command) {
+    PendingCommand pending;
+    pending.command = move(command);
+    future<CommandResult> result = pending.result.get_future();
+    while (!ring.tryPush(pending)) {
+        this_thread::yield();   // Full: the apply thread is behind
+    }
+
+    // Pairs with the exchange in run(). Both are read-modify-writes of
+    // sleeping, so one comes first: either the apply thread sees this command
+    // before parking, or this thread sees it parked and wakes it.
+    if (sleeping.exchange(false, memory_order_acq_rel)) {
+        lock_guard<mutex> lock(wakeMutex);
+        wake.notify_one();
+    }
+    return result;
+}
+
+void CommandQueue::run() {
+    vector<PendingCommand> batch;
+    vector<CommandResult> results;
+    batch.reserve(MAX_BATCH);
+    results.reserve(MAX_BATCH);
+    PendingCommand pending;
+    while (true) {
+        while (batch.size() < MAX_BATCH && ring.tryPop(pending)) {
+            batch.push_back(move(pending));
+        }
+
+        if (batch.empty()) {
+            unique_lock<mutex> lock(wakeMutex);
+            sleeping.exchange(true, memory_order_acq_rel);
+            if (stopping && ring.empty()) {
+                break;
+            }
+            wake.wait(lock, [this]() { return stopping || !ring.empty(); });
+            sleeping.store(false, memory_order_relaxed);
+            continue;
+        }
+
+        // Apply in order, commit once, then acknowledge: a caller never sees
+        // a result whose change could still be lost
+        // This thread is the only writer, so the calls skip their locks, and
+        // the batch's booking and credit changes become one journal append:
+        // after a crash, all of the batch is replayed or none of it
+        bookingManager.beginGroupCommit(auth);
+        for (PendingCommand& command : batch) {
+            results.push_back(apply(command.command));
+        }
+        if (!bookingManager.endGroupCommit(auth)) {
+            // The batch is applied but not on disk: fail every command that
+            // changed something, as the engine calls do outside a group
+            for (CommandResult& result : results) {
+                if (result.ok) {
+                    result.ok = false;
+                    if (!result.bookingId.empty()) {
+                        result.error = BookingError::NotSaved;
+                    }
+                    result.messages += "Error: Cannot write booking journal.\n";
+                }
+            }
+        }
+
+        commandCount.fetch_add(batch.size(), memory_order_relaxed);
+        batchCount.fetch_add(1, memory_order_relaxed);
+        for (size_t i = 0; i < batch.size(); i++) {
+            batch[i].result.set_value(move(results[i]));
+        }
+        batch.clear();
+        results.clear();
+    }
+}
+
+CommandResult CommandQueue::apply(const BookingCommand& command) {
+    CommandResult result;
+    result.sequence = ++applied;
+    ostringstream messages;
+    ScopedMessageStream capture(messages);
+
+    switch (command.type) {
+        case CommandType::CreateBooking: {
+            BookingRequest request = {command.username, command.target, command.startDate, command.endDate};
+            BookingResult booking = bookingManager.createBookings(vector<BookingRequest>(1, request), auth)[0];
+            result.ok = booking.created();
+            result.error = booking.error;
+            result.bookingId = booking.bookingId;
+            result.totalCost = booking.totalCost;
+            if (!result.ok) {
+                messageStream() << bookingErrorMessage(booking.error) << endl;
+            }
+            break;
+        }
+        case CommandType::ApproveBooking:
+            result.ok = bookingManager.approveBooking(command.target, command.username, auth);
+            break;
+        case CommandType::RejectBooking:
+            result.ok = bookingManager.rejectBooking(command.target, command.username);
+            break;
+        case CommandType::CompleteRental:
+            result.ok = bookingManager.completeRental(command.target, command.username);
+            break;
+        case CommandType::ListMotorbike: {
+            const MotorbikeListing& listing = *command.listing;
+            result.ok = bookingManager.listMotorbike(command.username, listing.brand, listing.model,
+                                                     listing.color, listing.size, listing.plateNo,
+                                                     listing.pricePerDay, listing.location,
+                                                     listing.availableStartDate, listing.availableEndDate,
+                                                     listing.minRenterRating);
+            break;
+        }
+        case CommandType::TopUpCredits:
+            result.ok = auth.topUpCreditPoints(command.username, command.amount);
+            break;
+        case CommandType::DeductCredits:
+            result.ok = auth.deductCreditPoints(command.username, command.amount);
+            break;
+    }
+    result.messages = messages.str();
+    return result;
+}
@@ -0,0 +1,69 @@
+#include "data_lock.h"
+#include "message_stream.h"
+#include <mutex>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// ============================================================================
+// DATA DIRECTORY LOCK IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+// The process's one descriptor for the lock file and its holders
+mutex holdersMutex;
+int lockFd = -1;
+int holders = 0;
+bool refusalReported = false;  // Auth and BookingManager print it once between them
+
+} // namespace
+
+DataLock::DataLock(const string& filename) : held(false) {
+    lock_guard<mutex> lock(holdersMutex);
+    if (holders > 0) {
+        holders++;
+        held = true;
+        return;
+    }
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        messageStream() << "Error: Cannot open " << filename << "." << endl;
+        return;
+    }
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        close(fd);
+        if (!refusalReported) {
+            messageStream() << "Error: Another program is using the data files (" << filename
+                            << " is locked). Stop it before starting this one." << endl;
+            refusalReported = true;
+        }
+        return;
+    }
+    lockFd = fd;
+#else
+    (void)filename;
+#endif
+    holders = 1;
+    held = true;
+    refusalReported = false;
+}
+
+DataLock::~DataLock() {
+    if (!held) {
+        return;
+    }
+    lock_guard<mutex> lock(holdersMutex);
+    if (--holders == 0 && lockFd >= 0) {
+#ifndef _WIN32
+        close(lockFd); // Releases the flock
+#endif
+        lockFd = -1;
+    }
+}
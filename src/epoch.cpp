@@ -0,0 +1,86 @@
+#include "epoch.h"
+
+using namespace std;
+
+// ============================================================================
+// EPOCH READER SLOTS
+// ============================================================================
+
+namespace {
+
+// One cache line per reader so pinning never bounces a line between cores
+struct alignas(64) ReaderSlot {
+    atomic<uint64_t> pinned{0};     // Epoch pinned by the owner, 0 when not reading
+    atomic<bool> claimed{false};
+};
+
+ReaderSlot readerSlots[MAX_READER_THREADS];
+atomic<size_t> slotsInUse{0};       // High-water mark; slots past it were never claimed
+atomic<uint64_t> globalEpoch{1};
+
+ReaderSlot* claimSlot() {
+    while (true) {
+        for (size_t i = 0; i < MAX_READER_THREADS; i++) {
+            bool expected = false;
+            if (!readerSlots[i].claimed.load(memory_order_relaxed) &&
+                readerSlots[i].claimed.compare_exchange_strong(expected, true)) {
+                size_t used = slotsInUse.load();
+                while (used < i + 1 && !slotsInUse.compare_exchange_weak(used, i + 1)) {
+                }
+                return &readerSlots[i];
+            }
+        }
+        this_thread::yield();   // Every slot is taken; wait for a reader thread to exit
+    }
+}
+
+// The calling thread's slot, claimed on first use and released when it exits
+struct ThreadReader {
+    ReaderSlot* slot = nullptr;
+    int depth = 0;
+
+    ~ThreadReader() {
+        if (slot) {
+            slot->claimed.store(false, memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadReader threadReader;
+
+} // namespace
+
+EpochGuard::EpochGuard() {
+    ThreadReader& reader = threadReader;
+    if (reader.depth++ == 0) {
+        if (!reader.slot) {
+            reader.slot = claimSlot();
+        }
+        // Sequentially consistent, so the pin is visible before the reader
+        // loads any published pointer
+        reader.slot->pinned.store(globalEpoch.load());
+    }
+}
+
+EpochGuard::~EpochGuard() {
+    ThreadReader& reader = threadReader;
+    if (--reader.depth == 0) {
+        reader.slot->pinned.store(0, memory_order_release);
+    }
+}
+
+uint64_t advanceEpoch() {
+    return globalEpoch.fetch_add(1) + 1;
+}
+
+uint64_t oldestPinnedEpoch() {
+    uint64_t oldest = UINT64_MAX;
+    size_t used = slotsInUse.load();
+    for (size_t i = 0; i < used; i++) {
+        uint64_t pinned = readerSlots[i].pinned.load();
+        if (pinned != 0 && pinned < oldest) {
+            oldest = pinned;
+        }
+    }
+    return oldest;
+}
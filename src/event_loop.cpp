@@ -0,0 +1,103 @@
+#include "event_loop.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace std;
+
+// ============================================================================
+// EVENT LOOP IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+const int MAX_EVENTS = 256;
+
+} // namespace
+
+EventLoop::EventLoop()
+    : epollFd(epoll_create1(EPOLL_CLOEXEC)),
+      wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      stopping(false) {
+    if (isValid()) {
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = wakeFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+    }
+}
+
+EventLoop::~EventLoop() {
+    if (wakeFd >= 0) {
+        close(wakeFd);
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+}
+
+bool EventLoop::add(int fd, uint32_t events, Handler handler) {
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        return false;
+    }
+    handlers[fd] = make_shared<Handler>(move(handler));
+    return true;
+}
+
+bool EventLoop::modify(int fd, uint32_t events) {
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+    return epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+void EventLoop::remove(int fd) {
+    if (handlers.erase(fd)) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
+
+void EventLoop::run() {
+    epoll_event events[MAX_EVENTS];
+    while (!stopping.load()) {
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (int i = 0; i < ready && !stopping.load(); i++) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                continue;
+            }
+            // An earlier handler in this batch may have removed fd
+            auto it = handlers.find(fd);
+            if (it == handlers.end()) {
+                continue;
+            }
+            shared_ptr<Handler> handler = it->second;
+            (*handler)(events[i].events);
+        }
+    }
+    stopping.store(false);
+    uint64_t drained;
+    while (read(wakeFd, &drained, sizeof(drained)) > 0) {
+    }
+}
+
+void EventLoop::stop() {
+    stopping.store(true);
+    uint64_t one = 1;
+    ssize_t written = write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+#endif
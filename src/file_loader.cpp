@@ -0,0 +1,112 @@
+#include "file_loader.h"
+#include <fstream>
+#include <sstream>
+#include <charconv>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// ============================================================================
+// MAPPED FILE IMPLEMENTATION
+// ============================================================================
+
+MappedFile::MappedFile(const string& filename)
+    : data(nullptr), length(0), mapped(false), opened(false) {
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == 0) {
+        opened = true;
+        if (info.st_size > 0) {
+            void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED) {
+                madvise(address, info.st_size, MADV_SEQUENTIAL);
+                data = static_cast<const char*>(address);
+                length = info.st_size;
+                mapped = true;
+            } else {
+                opened = false;
+            }
+        }
+    }
+    close(fd);
+    if (mapped || !opened) {
+        return;
+    }
+#endif
+
+    // Fallback: read the whole file into a single buffer
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+    ostringstream contents;
+    contents << file.rdbuf();
+    buffer = contents.str();
+    data = buffer.data();
+    length = buffer.size();
+    opened = true;
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char*>(data), length);
+    }
+#endif
+}
+
+// ============================================================================
+// RECORD PARSING HELPERS
+// ============================================================================
+
+string_view trimField(string_view field) {
+    size_t start = field.find_first_not_of(" \t\r\n");
+    if (start == string_view::npos) {
+        return string_view();
+    }
+    size_t end = field.find_last_not_of(" \t\r\n");
+    return field.substr(start, end - start + 1);
+}
+
+size_t splitRecord(string_view line, string_view* fields, size_t maxFields) {
+    size_t count = 0;
+    size_t pos = 0;
+    while (count < maxFields) {
+        size_t sep = line.find('|', pos);
+        if (sep == string_view::npos) {
+            // Match getline(): a trailing separator does not produce an empty field
+            if (pos < line.size()) {
+                fields[count++] = trimField(line.substr(pos));
+            }
+            break;
+        }
+        fields[count++] = trimField(line.substr(pos, sep - pos));
+        pos = sep + 1;
+    }
+    return count;
+}
+
+double parseDouble(string_view field, double fallback) {
+    double value = fallback;
+    from_chars_result result = from_chars(field.data(), field.data() + field.size(), value);
+    if (result.ec != errc()) {
+        return fallback;
+    }
+    return value;
+}
+
+size_t countLines(string_view text) {
+    return count(text.begin(), text.end(), '\n') + 1;
+}
@@ -0,0 +1,266 @@
+#include "http_request.h"
+#include <cstdint>
+
+using namespace std;
+
+// ============================================================================
+// HTTP REQUEST PARSER
+// ============================================================================
+
+namespace {
+
+char lower(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool equalsIgnoreCase(string_view a, string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (lower(a[i]) != lower(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// True if the comma-separated header value lists token (case-insensitive)
+bool hasToken(string_view value, string_view token) {
+    while (!value.empty()) {
+        size_t comma = value.find(',');
+        string_view item = value.substr(0, comma);
+        size_t first = item.find_first_not_of(" \t");
+        size_t last = item.find_last_not_of(" \t");
+        if (first != string_view::npos && equalsIgnoreCase(item.substr(first, last - first + 1), token)) {
+            return true;
+        }
+        if (comma == string_view::npos) {
+            break;
+        }
+        value.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+bool isTokenChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           string_view("!#$%&'*+-.^_`|~").find(c) != string_view::npos;
+}
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    c = lower(c);
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// Parses "METHOD SP target SP HTTP/1.x"
+HttpParseStatus parseRequestLine(string_view line, HttpRequest& request) {
+    size_t methodEnd = line.find(' ');
+    if (methodEnd == 0 || methodEnd == string_view::npos) {
+        return HttpParseStatus::BadRequest;
+    }
+    request.method = line.substr(0, methodEnd);
+    for (char c : request.method) {
+        if (!isTokenChar(c)) {
+            return HttpParseStatus::BadRequest;
+        }
+    }
+    size_t targetEnd = line.find(' ', methodEnd + 1);
+    if (targetEnd == string_view::npos || targetEnd == methodEnd + 1 || line[methodEnd + 1] != '/') {
+        return HttpParseStatus::BadRequest;
+    }
+    string_view target = line.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    size_t question = target.find('?');
+    request.path = target.substr(0, question);
+    request.query = question == string_view::npos ? string_view() : target.substr(question + 1);
+
+    string_view version = line.substr(targetEnd + 1);
+    if (version.size() != 8 || version.substr(0, 5) != "HTTP/" || version[6] != '.' ||
+        version[5] < '0' || version[5] > '9' || version[7] < '0' || version[7] > '9') {
+        return HttpParseStatus::BadRequest;
+    }
+    if (version[5] != '1') {
+        return HttpParseStatus::VersionNotSupported;
+    }
+    request.minorVersion = version[7] - '0';
+    return HttpParseStatus::Complete;
+}
+
+} // namespace
+
+string_view HttpRequest::header(string_view name) const {
+    for (size_t i = 0; i < headerCount; i++) {
+        if (equalsIgnoreCase(headers[i].name, name)) {
+            return headers[i].value;
+        }
+    }
+    return string_view();
+}
+
+HttpParseStatus parseHttpRequest(string_view input, HttpRequest& request) {
+    // Empty lines before a request are ignored (RFC 9112 section 2.2)
+    size_t start = 0;
+    while (start + 1 < input.size() && input[start] == '\r' && input[start + 1] == '\n') {
+        start += 2;
+    }
+    size_t headEnd = input.find("\r\n\r\n", start);
+
+    // Lines must end in CRLF; a bare LF is rejected now rather than left
+    // waiting for a blank line that a LF-only client never sends
+    size_t scanEnd = headEnd == string_view::npos ? input.size() : headEnd;
+    for (size_t lf = input.find('\n', start); lf < scanEnd; lf = input.find('\n', lf + 1)) {
+        if (lf == start || input[lf - 1] != '\r') {
+            return HttpParseStatus::BadRequest;
+        }
+    }
+    if (headEnd == string_view::npos) {
+        return input.size() - start > MAX_HTTP_HEAD_SIZE ? HttpParseStatus::HeadersTooLarge
+                                                          : HttpParseStatus::Incomplete;
+    }
+    if (headEnd - start > MAX_HTTP_HEAD_SIZE) {
+        return HttpParseStatus::HeadersTooLarge;
+    }
+
+    string_view head = input.substr(start, headEnd - start + 2);   // Each line keeps its CRLF
+    size_t lineEnd = head.find("\r\n");
+    HttpParseStatus status = parseRequestLine(head.substr(0, lineEnd), request);
+    if (status != HttpParseStatus::Complete) {
+        return status;
+    }
+
+    request.headerCount = 0;
+    size_t contentLength = 0;
+    bool hasContentLength = false;
+    for (size_t line = lineEnd + 2; line < head.size(); line = lineEnd + 2) {
+        lineEnd = head.find("\r\n", line);
+        string_view text = head.substr(line, lineEnd - line);
+        size_t colon = text.find(':');
+        // Folded continuation lines and names with spaces are rejected
+        if (colon == 0 || colon == string_view::npos || request.headerCount == MAX_HTTP_HEADERS) {
+            return request.headerCount == MAX_HTTP_HEADERS ? HttpParseStatus::HeadersTooLarge
+                                                           : HttpParseStatus::BadRequest;
+        }
+        HttpHeader& header = request.headers[request.headerCount++];
+        header.name = text.substr(0, colon);
+        for (char c : header.name) {
+            if (!isTokenChar(c)) {
+                return HttpParseStatus::BadRequest;
+            }
+        }
+        string_view value = text.substr(colon + 1);
+        size_t first = value.find_first_not_of(" \t");
+        size_t last = value.find_last_not_of(" \t");
+        header.value = first == string_view::npos ? string_view() : value.substr(first, last - first + 1);
+
+        if (equalsIgnoreCase(header.name, "Content-Length")) {
+            if (header.value.empty()) {
+                return HttpParseStatus::BadRequest;
+            }
+            size_t length = 0;
+            for (char c : header.value) {
+                if (c < '0' || c > '9') {
+                    return HttpParseStatus::BadRequest;
+                }
+                length = length * 10 + static_cast<size_t>(c - '0');
+                if (length > MAX_HTTP_BODY_SIZE) {
+                    return HttpParseStatus::BodyTooLarge;
+                }
+            }
+            if (hasContentLength && length != contentLength) {
+                return HttpParseStatus::BadRequest;
+            }
+            contentLength = length;
+            hasContentLength = true;
+        } else if (equalsIgnoreCase(header.name, "Transfer-Encoding")) {
+            return HttpParseStatus::NotImplemented;
+        }
+    }
+
+    size_t bodyStart = headEnd + 4;
+    if (input.size() - bodyStart < contentLength) {
+        return HttpParseStatus::Incomplete;
+    }
+    request.body = input.substr(bodyStart, contentLength);
+    request.length = bodyStart + contentLength;
+
+    string_view connection = request.header("Connection");
+    request.keepAlive = request.minorVersion >= 1 ? !hasToken(connection, "close")
+                                                  : hasToken(connection, "keep-alive");
+    return HttpParseStatus::Complete;
+}
+
+// ============================================================================
+// FORM AND AUTHORIZATION DECODING
+// ============================================================================
+
+bool formValue(string_view form, string_view name, string& storage, string_view& value) {
+    while (!form.empty()) {
+        size_t amp = form.find('&');
+        string_view pair = form.substr(0, amp);
+        size_t equals = pair.find('=');
+        if (pair.substr(0, equals) == name) {
+            string_view raw = equals == string_view::npos ? string_view() : pair.substr(equals + 1);
+            if (raw.find_first_of("%+") == string_view::npos) {
+                value = raw;
+                return true;
+            }
+            storage.clear();
+            for (size_t i = 0; i < raw.size(); i++) {
+                int high = 0;
+                int low = 0;
+                if (raw[i] == '+') {
+                    storage.push_back(' ');
+                } else if (raw[i] == '%' && i + 2 < raw.size() &&
+                           (high = hexDigit(raw[i + 1])) >= 0 && (low = hexDigit(raw[i + 2])) >= 0) {
+                    storage.push_back(static_cast<char>(high * 16 + low));
+                    i += 2;
+                } else {
+                    storage.push_back(raw[i]);
+                }
+            }
+            value = storage;
+            return true;
+        }
+        if (amp == string_view::npos) {
+            break;
+        }
+        form.remove_prefix(amp + 1);
+    }
+    return false;
+}
+
+// Padded input only: the length is a multiple of 4, there are at most two
+// '=' and only at the end, and the bits they pad out are zero
+bool decodeBase64(string_view text, string& decoded) {
+    decoded.clear();
+    if (text.size() % 4 != 0) {
+        return false;
+    }
+    size_t dataEnd = text.find_last_not_of('=') + 1;    // 0 when all '=' (npos + 1)
+    if (text.size() - dataEnd > 2) {
+        return false;
+    }
+    uint32_t bits = 0;
+    int count = 0;
+    for (size_t i = 0; i < dataEnd; i++) {
+        char c = text[i];
+        int digit;
+        if (c >= 'A' && c <= 'Z') digit = c - 'A';
+        else if (c >= 'a' && c <= 'z') digit = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') digit = c - '0' + 52;
+        else if (c == '+') digit = 62;
+        else if (c == '/') digit = 63;
+        else return false;
+        bits = bits << 6 | static_cast<uint32_t>(digit);
+        count += 6;
+        if (count >= 8) {
+            count -= 8;
+            decoded.push_back(static_cast<char>((bits >> count) & 0xFF));
+        }
+    }
+    // One padding character leaves 2 spare bits, two leave 4; a single data
+    // character in the last group (6 spare bits) cannot encode a byte
+    return count == static_cast<int>(text.size() - dataEnd) * 2 && (bits & ((1u << count) - 1)) == 0;
+}
@@ -0,0 +1,425 @@
+#include "http_server.h"
+
+#ifdef __linux__
+#include "auth.h"
+#include "json_writer.h"
+#include "statistics.h"
+#include <charconv>
+
+using namespace std;
+
+// ============================================================================
+// HTTP SERVER IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+const size_t MAX_SEARCH_LIMIT = 100;
+const char LENGTH_PLACEHOLDER[] = "          ";     // Room for any body length
+const size_t LENGTH_WIDTH = sizeof(LENGTH_PLACEHOLDER) - 1;
+const char AUTHENTICATE_HEADER[] = "WWW-Authenticate: Basic realm=\"E-Motorbike Rental\"\r\n";
+
+string_view statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 409: return "Conflict";
+        case 413: return "Content Too Large";
+        case 422: return "Unprocessable Content";
+        case 431: return "Request Header Fields Too Large";
+        case 501: return "Not Implemented";
+        case 505: return "HTTP Version Not Supported";
+        default: return "Internal Server Error";
+    }
+}
+
+int parseStatusCode(HttpParseStatus status) {
+    switch (status) {
+        case HttpParseStatus::BodyTooLarge: return 413;
+        case HttpParseStatus::HeadersTooLarge: return 431;
+        case HttpParseStatus::NotImplemented: return 501;
+        case HttpParseStatus::VersionNotSupported: return 505;
+        default: return 400;
+    }
+}
+
+int bookingErrorStatus(BookingError error) {
+    switch (error) {
+        case BookingError::MotorbikeNotFound: return 404;
+        case BookingError::InvalidDates: return 400;
+        case BookingError::AlreadyBooked:
+        case BookingError::BatchConflict: return 409;
+        case BookingError::NotSaved: return 500;
+        default: return 422;
+    }
+}
+
+// Form field from the body of a form POST, else from the query string
+bool requestValue(const HttpRequest& request, string_view name, string& storage, string_view& value) {
+    return formValue(request.body, name, storage, value) || formValue(request.query, name, storage, value);
+}
+
+template <typename Number>
+bool parseNumber(string_view text, Number& number) {
+    from_chars_result result = from_chars(text.data(), text.data() + text.size(), number);
+    return result.ec == errc() && result.ptr == text.data() + text.size();
+}
+
+void writeMotorbike(JsonWriter& json, const Motorbike& motorbike) {
+    json.beginObject()
+        .member("motorbikeId", motorbike.getMotorbikeId())
+        .member("owner", motorbike.getOwnerUsername())
+        .member("brand", motorbike.getBrand())
+        .member("model", motorbike.getModel())
+        .member("color", motorbike.getColor())
+        .member("size", motorbike.getSize())
+        .member("plateNo", motorbike.getPlateNo())
+        .member("pricePerDay", motorbike.getPricePerDay())
+        .member("location", motorbike.getLocation())
+        .member("rating", motorbike.getRating())
+        .member("description", motorbike.getDescription())
+        .member("availableStart", motorbike.getAvailableStart())
+        .member("availableEnd", motorbike.getAvailableEnd())
+        .member("minRenterRating", motorbike.getMinRenterRating())
+        .endObject();
+}
+
+void writeBooking(JsonWriter& json, const Booking& booking) {
+    json.beginObject()
+        .member("bookingId", booking.getBookingId())
+        .member("renter", booking.getRenterUsername())
+        .member("owner", booking.getOwnerUsername())
+        .member("motorbikeId", booking.getMotorbikeId())
+        .member("startDate", booking.getStart())
+        .member("endDate", booking.getEnd())
+        .member("status", booking.getStatus())
+        .member("totalCost", booking.getTotalCost())
+        .member("brand", booking.getBrand())
+        .member("model", booking.getModel())
+        .member("plateNo", booking.getPlateNo())
+        .endObject();
+}
+
+} // namespace
+
+HttpServer::HttpServer(EventLoop& loop, Auth& auth, BookingManager& bookingManager)
+    : SocketServer(loop), auth(auth), bookingManager(bookingManager) {
+}
+
+// Answers every complete request in order while the output backlog allows it
+size_t HttpServer::handleInput(Connection& connection) {
+    size_t consumed = 0;
+    while (!backlogFull(connection)) {
+        HttpRequest request;
+        HttpParseStatus status = parseHttpRequest(string_view(connection.input).substr(consumed), request);
+        if (status == HttpParseStatus::Incomplete) {
+            break;
+        }
+        if (status != HttpParseStatus::Complete) {
+            // The stream can no longer be framed; answer and hang up
+            int code = parseStatusCode(status);
+            sendError(connection, code, statusText(code), false);
+            connection.closing = true;
+            return connection.input.size();
+        }
+        beginRequest();
+        handleRequest(connection, request);
+        consumed += request.length;
+        if (!request.keepAlive) {
+            connection.closing = true;
+            return connection.input.size();
+        }
+    }
+    return consumed;
+}
+
+void HttpServer::handleRequest(Connection& connection, const HttpRequest& request) {
+    const string_view prefix = "/api/";
+    if (request.path.substr(0, prefix.size()) != prefix) {
+        sendError(connection, 404, "Not found.", request.keepAlive);
+        return;
+    }
+    string_view route = request.path.substr(prefix.size());
+    bool get = request.method == "GET";
+    bool post = request.method == "POST";
+
+    if (route == "admin/statistics") {
+        if (!get) {
+            sendError(connection, 405, "Use GET.", request.keepAlive, "Allow: GET\r\n");
+            return;
+        }
+        handleStatistics(connection, request);
+        return;
+    }
+
+    // Every other route acts for a member
+    bool known = route == "motorbikes" || route == "bookings" || route == "requests" ||
+                 route.substr(0, 9) == "bookings/";
+    if (!known) {
+        sendError(connection, 404, "Not found.", request.keepAlive);
+        return;
+    }
+    const User* user = authenticate(request, false);
+    if (!user) {
+        sendError(connection, 401, "Member credentials required.", request.keepAlive, AUTHENTICATE_HEADER);
+        return;
+    }
+
+    if (route == "motorbikes" && get) {
+        handleSearch(connection, request, *user);
+    } else if (route == "bookings" && get) {
+        handleBookingList(connection, request, *user, false);
+    } else if (route == "bookings" && post) {
+        handleCreateBooking(connection, request, *user);
+    } else if (route == "requests" && get) {
+        handleBookingList(connection, request, *user, true);
+    } else if (route.substr(0, 9) == "bookings/") {
+        // bookings/{id}/approve or bookings/{id}/reject
+        string_view rest = route.substr(9);
+        size_t slash = rest.find('/');
+        string_view action = slash == string_view::npos ? string_view() : rest.substr(slash + 1);
+        if (slash == 0 || (action != "approve" && action != "reject")) {
+            sendError(connection, 404, "Not found.", request.keepAlive);
+        } else if (!post) {
+            sendError(connection, 405, "Use POST.", request.keepAlive, "Allow: POST\r\n");
+        } else {
+            handleDecision(connection, request, *user, rest.substr(0, slash), action == "approve");
+        }
+    } else {
+        sendError(connection, 405, "Method not allowed.", request.keepAlive,
+                  route == "bookings" ? "Allow: GET, POST\r\n" : "Allow: GET\r\n");
+    }
+}
+
+// The user named by Basic credentials, if they are valid for the role
+const User* HttpServer::authenticate(const HttpRequest& request, bool admin) {
+    string_view authorization = request.header("Authorization");
+    if (authorization.size() < 6 || (authorization.substr(0, 6) != "Basic " && authorization.substr(0, 6) != "basic ")) {
+        return nullptr;
+    }
+    string credentials;
+    if (!decodeBase64(authorization.substr(6), credentials)) {
+        return nullptr;
+    }
+    size_t colon = credentials.find(':');
+    if (colon == string::npos) {
+        return nullptr;
+    }
+    return auth.checkCredentials(credentials.substr(0, colon), credentials.substr(colon + 1),
+                                 admin ? "admin" : "member");
+}
+
+void HttpServer::handleSearch(Connection& connection, const HttpRequest& request, const User& user) {
+    string startStorage, endStorage, cityStorage, scratch;
+    string_view start, end, city, text;
+    if (!requestValue(request, "start", startStorage, start) || !requestValue(request, "city", cityStorage, city)) {
+        sendError(connection, 400, "start and city are required.", request.keepAlive);
+        return;
+    }
+    SearchRequest search;
+    search.startDate = string(start);
+    search.city = string(city);
+    if (requestValue(request, "end", endStorage, end)) {
+        search.endDate = string(end);
+    }
+    if (requestValue(request, "sort", scratch, text)) {
+        if (text == "rating") {
+            search.sortKey = SearchSortKey::Rating;
+        } else if (text == "total") {
+            search.sortKey = SearchSortKey::TotalCost;
+        } else if (text != "price") {
+            sendError(connection, 400, "sort must be price, rating or total.", request.keepAlive);
+            return;
+        }
+    }
+    if (requestValue(request, "limit", scratch, text) && !parseNumber(text, search.limit)) {
+        sendError(connection, 400, "limit must be a number.", request.keepAlive);
+        return;
+    }
+    search.limit = min(search.limit, MAX_SEARCH_LIMIT);
+    string_view afterKey, afterSlot;
+    string keyStorage;
+    if (requestValue(request, "afterKey", keyStorage, afterKey) && requestValue(request, "afterSlot", scratch, afterSlot)) {
+        if (!parseNumber(afterKey, search.after.key) || !parseNumber(afterSlot, search.after.slot)) {
+            sendError(connection, 400, "afterKey and afterSlot must be numbers.", request.keepAlive);
+            return;
+        }
+        search.after.valid = true;
+    }
+
+    SearchPage page = bookingManager.searchMotorbikesPage(search, user.getUsername(), auth);
+    Response response = beginResponse(connection, 200, request.keepAlive);
+    JsonWriter json(connection.output);
+    json.beginObject()
+        .member("totalMatches", page.totalMatches)
+        .member("hasMore", page.hasMore);
+    json.key("next");
+    if (page.hasMore) {
+        json.beginObject().member("afterKey", page.next.key).member("afterSlot", page.next.slot).endObject();
+    } else {
+        json.null();
+    }
+    json.key("motorbikes").beginArray();
+    for (const Motorbike& motorbike : page.results) {
+        writeMotorbike(json, motorbike);
+    }
+    json.endArray().endObject();
+    endResponse(connection, response);
+}
+
+void HttpServer::handleCreateBooking(Connection& connection, const HttpRequest& request, const User& user) {
+    string idStorage, startStorage, endStorage;
+    string_view motorbikeId, start, end;
+    if (!requestValue(request, "motorbikeId", idStorage, motorbikeId) ||
+        !requestValue(request, "start", startStorage, start) || !requestValue(request, "end", endStorage, end)) {
+        sendError(connection, 400, "motorbikeId, start and end are required.", request.keepAlive);
+        return;
+    }
+    vector<BookingRequest> batch(1);
+    batch[0].renter = user.getUsername();
+    batch[0].motorbikeId = string(motorbikeId);
+    batch[0].startDate = string(start);
+    batch[0].endDate = string(end);
+    BookingResult result = bookingManager.createBookings(batch, auth)[0];
+    if (!result.created()) {
+        sendError(connection, bookingErrorStatus(result.error), bookingErrorMessage(result.error), request.keepAlive);
+        return;
+    }
+    Response response = beginResponse(connection, 201, request.keepAlive);
+    JsonWriter(connection.output).beginObject()
+        .member("bookingId", result.bookingId)
+        .member("motorbikeId", motorbikeId)
+        .member("startDate", Date::parse(start))
+        .member("endDate", Date::parse(end))
+        .member("status", "Pending")
+        .member("totalCost", result.totalCost)
+        .endObject();
+    endResponse(connection, response);
+}
+
+// Pending requests on the user's motorbikes, or the user's own bookings
+void HttpServer::handleBookingList(Connection& connection, const HttpRequest& request, const User& user,
+                                   bool rentalRequests) {
+    bookingScratch.clear();
+    auto collect = [&](const Booking& booking) { bookingScratch.push_back(&booking); };
+    if (rentalRequests) {
+        bookingManager.forEachRentalRequest(user.getUsername(), collect);
+    } else {
+        bookingManager.forEachUserBooking(user.getUsername(), collect);
+    }
+    Response response = beginResponse(connection, 200, request.keepAlive);
+    JsonWriter json(connection.output);
+    json.beginObject().key("bookings").beginArray();
+    for (const Booking* booking : bookingScratch) {
+        writeBooking(json, *booking);
+    }
+    json.endArray().endObject();
+    endResponse(connection, response);
+}
+
+void HttpServer::handleDecision(Connection& connection, const HttpRequest& request, const User& user,
+                                string_view bookingId, bool approve) {
+    string id(bookingId);
+    bool done = approve ? bookingManager.approveBooking(id, user.getUsername(), auth)
+                        : bookingManager.rejectBooking(id, user.getUsername());
+    if (!done) {
+        string message = lastMessage();
+        sendError(connection, 409, message.empty() ? "No pending request " + id + " on your motorbike." : message,
+                  request.keepAlive);
+        return;
+    }
+    Response response = beginResponse(connection, 200, request.keepAlive);
+    JsonWriter(connection.output).beginObject()
+        .member("bookingId", bookingId)
+        .member("status", approve ? "Approved" : "Rejected")
+        .endObject();
+    endResponse(connection, response);
+}
+
+void HttpServer::handleStatistics(Connection& connection, const HttpRequest& request) {
+    if (!authenticate(request, true)) {
+        sendError(connection, 401, "Admin credentials required.", request.keepAlive, AUTHENTICATE_HEADER);
+        return;
+    }
+    SystemStatistics stats = collectStatistics(auth, bookingManager);
+    Response response = beginResponse(connection, 200, request.keepAlive);
+    JsonWriter json(connection.output);
+    json.beginObject();
+    json.key("users").beginObject()
+        .member("total", stats.totalUsers)
+        .member("members", stats.members)
+        .member("admins", stats.admins)
+        .member("totalCreditPoints", stats.totalCreditPoints)
+        .member("averageMemberRating", stats.averageMemberRating)
+        .endObject();
+    json.key("motorbikes").beginObject()
+        .member("total", stats.totalMotorbikes)
+        .member("listed", stats.listedMotorbikes)
+        .member("available", stats.availableMotorbikes)
+        .member("totalDailyValue", stats.totalDailyValue)
+        .member("averageRating", stats.averageMotorbikeRating)
+        .endObject();
+    json.key("bookings").beginObject()
+        .member("total", stats.totalBookings)
+        .member("pending", stats.pendingBookings)
+        .member("approved", stats.approvedBookings)
+        .member("completed", stats.completedBookings)
+        .member("rejected", stats.rejectedBookings)
+        .member("totalValue", stats.totalBookingValue)
+        .endObject();
+    json.key("searchCache").beginObject()
+        .member("hits", stats.searchCache.hits)
+        .member("misses", stats.searchCache.misses)
+        .member("invalidations", stats.searchCache.invalidations)
+        .member("evictions", stats.searchCache.evictions)
+        .member("entries", stats.searchCache.entries)
+        .endObject();
+    json.endObject();
+    endResponse(connection, response);
+}
+
+// ============================================================================
+// RESPONSE FRAMING
+// ============================================================================
+
+// Writes the status line and headers; Content-Length is left blank-padded
+// and filled in by endResponse once the body is in place
+HttpServer::Response HttpServer::beginResponse(Connection& connection, int status, bool keepAlive,
+                                               string_view extraHeaders) {
+    string& out = connection.output;
+    char code[4];
+    to_chars(code, code + 3, status);
+    out.append("HTTP/1.1 ").append(code, 3).append(" ").append(statusText(status)).append("\r\n");
+    out.append("Content-Type: application/json\r\n");
+    out.append(keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n");
+    out.append(extraHeaders.data(), extraHeaders.size());
+    out.append("Content-Length: ");
+    Response response;
+    response.lengthField = out.size();
+    out.append(LENGTH_PLACEHOLDER).append("\r\n\r\n");
+    response.bodyStart = out.size();
+    return response;
+}
+
+void HttpServer::endResponse(Connection& connection, const Response& response) {
+    string& out = connection.output;
+    char digits[LENGTH_WIDTH];
+    to_chars_result result = to_chars(digits, digits + LENGTH_WIDTH, out.size() - response.bodyStart);
+    size_t length = result.ptr - digits;
+    // Left-aligned digits; the spaces after them are optional whitespace
+    out.replace(response.lengthField, length, digits, length);
+}
+
+void HttpServer::sendError(Connection& connection, int status, string_view message, bool keepAlive,
+                           string_view extraHeaders) {
+    Response response = beginResponse(connection, status, keepAlive, extraHeaders);
+    JsonWriter(connection.output).beginObject().member("error", message).endObject();
+    endResponse(connection, response);
+}
+
+#endif
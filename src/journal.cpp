@@ -0,0 +1,234 @@
+#include "journal.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Thin wrappers over the file descriptor calls, so commit can tell the
+// records reached the disk rather than an in-process buffer
+
+static int openFile(const string& filename, bool append) {
+#ifdef _WIN32
+    int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : _O_TRUNC);
+    return _open(filename.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+    return ::open(filename.c_str(), flags, 0644);
+#endif
+}
+
+static void closeFile(int fd) {
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+static long long fileSize(int fd) {
+#ifdef _WIN32
+    return _lseeki64(fd, 0, SEEK_END);
+#else
+    return lseek(fd, 0, SEEK_END);
+#endif
+}
+
+// Writes all of data and waits until it is on the disk
+static bool writeDurably(int fd, const string& data) {
+    size_t done = 0;
+    while (done < data.size()) {
+#ifdef _WIN32
+        int chunk = _write(fd, data.data() + done, static_cast<unsigned>(min(data.size() - done, size_t(INT_MAX))));
+#else
+        ssize_t chunk = ::write(fd, data.data() + done, data.size() - done);
+        if (chunk < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+        if (chunk <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(chunk);
+    }
+#if defined(_WIN32)
+    return _commit(fd) == 0;
+#elif defined(__APPLE__)
+    return fsync(fd) == 0;
+#else
+    return fdatasync(fd) == 0;
+#endif
+}
+
+// Cuts off what a failed write left behind, so a retry does not follow a torn line
+static void truncateFile(int fd, long long size) {
+#ifdef _WIN32
+    (void)_chsize_s(fd, size);
+#else
+    (void)ftruncate(fd, size);
+#endif
+}
+
+Journal::Journal(string filename, string header)
+    : filename(move(filename)), header(move(header)), fd(-1), opened(false), written(0), appended(0),
+      recordCount(0) {
+}
+
+Journal::~Journal() {
+    if (fd >= 0) {
+        closeFile(fd);
+    }
+}
+
+bool Journal::open(int existingRecords) {
+    fd = openFile(filename, true);
+    if (fd < 0) {
+        return false;
+    }
+    if (fileSize(fd) == 0 && !writeDurably(fd, header + "\n")) {
+        closeFile(fd);
+        fd = -1;
+        return false;
+    }
+    recordCount = existingRecords;
+    opened = true;
+    return true;
+}
+
+uint64_t Journal::append(const string& records, int count) {
+    if (!opened || count == 0) {
+        return 0;
+    }
+    lock_guard<mutex> tail(tailMutex);
+    entries.push_back({++appended, count > 1 ? "B|" + to_string(count) + "\n" + records : records, count});
+    recordCount += count;
+    return appended;
+}
+
+bool Journal::commit(uint64_t sequence) {
+    lock_guard<mutex> lock(fileMutex);
+    if (written >= sequence) {
+        return true; // An earlier committer wrote it
+    }
+    if (fd < 0) {
+        return false;
+    }
+
+    string batch;
+    uint64_t through;
+    {
+        lock_guard<mutex> tail(tailMutex);
+        auto first = entries.end();
+        while (first != entries.begin() && (first - 1)->sequence > written) {
+            --first;
+        }
+        for (auto it = first; it != entries.end(); ++it) {
+            batch += it->records;
+        }
+        through = appended;
+    }
+    long long size = fileSize(fd);
+    if (size < 0 || !writeDurably(fd, batch)) {
+        if (size >= 0) {
+            truncateFile(fd, size);
+        }
+        return false; // written stays put: the next commit writes these records again
+    }
+    written = through;
+    return true;
+}
+
+uint64_t Journal::lastSequence() {
+    lock_guard<mutex> tail(tailMutex);
+    return appended;
+}
+
+bool Journal::rewrite(const string& carried, int carriedCount, uint64_t through) {
+    lock_guard<mutex> lock(fileMutex);
+    string kept;
+    uint64_t keptThrough;
+    {
+        lock_guard<mutex> tail(tailMutex);
+        while (!entries.empty() && entries.front().sequence <= through) {
+            entries.pop_front();
+        }
+        int keptCount = 0;
+        for (const Entry& entry : entries) {
+            kept += entry.records;
+            keptCount += entry.count;
+        }
+        keptThrough = appended;
+        recordCount = carriedCount + keptCount;
+    }
+
+    string tempFilename = filename + ".tmp";
+    int temp = openFile(tempFilename, false);
+    if (temp < 0) {
+        return false;
+    }
+    bool saved = writeDurably(temp, header + "\n" + carried + kept);
+    closeFile(temp);
+    if (!saved) {
+        remove(tempFilename.c_str());
+        return false;
+    }
+
+    if (fd >= 0) {
+        closeFile(fd);
+    }
+#ifdef _WIN32
+    remove(filename.c_str()); // rename() does not replace existing files on Windows
+#endif
+    bool renamed = rename(tempFilename.c_str(), filename.c_str()) == 0;
+    fd = openFile(filename, true);
+    opened = fd >= 0;
+    if (renamed) {
+        written = keptThrough;
+    }
+    return renamed;
+}
+
+void Journal::replay(const string& filename, const function<void(const string&)>& apply) {
+    ifstream file(filename);
+    string line;
+    vector<string> group;
+    size_t groupSize = 0;   // Records of the open group, 0 = none open
+    while (getline(file, line)) {
+        if (file.eof()) {
+            break; // No newline: the write of this line was cut short
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (line.compare(0, 2, "B|") == 0) {
+            group.clear(); // An unfinished group before this one is dropped
+            groupSize = strtoul(line.c_str() + 2, nullptr, 10);
+            continue;
+        }
+        if (groupSize == 0) {
+            apply(line);
+            continue;
+        }
+        group.push_back(line);
+        if (group.size() == groupSize) {
+            for (const string& record : group) {
+                apply(record);
+            }
+            group.clear();
+            groupSize = 0;
+        }
+    }
+}
@@ -0,0 +1,135 @@
+#include "json_writer.h"
+#include "date.h"
+#include <charconv>
+#include <cmath>
+
+using namespace std;
+
+// ============================================================================
+// JSON WRITER IMPLEMENTATION
+// ============================================================================
+
+JsonWriter::JsonWriter(string& out) : out(out), hasItems(0), depth(0), afterKey(false) {
+}
+
+// Comma before every value but the first in its container; a value that
+// follows key() was already separated by the key
+void JsonWriter::separate() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    uint64_t bit = 1ULL << depth;
+    if (hasItems & bit) {
+        out.push_back(',');
+    }
+    hasItems |= bit;
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    separate();
+    out.push_back('{');
+    depth++;
+    hasItems &= ~(1ULL << depth);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    depth--;
+    out.push_back('}');
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    separate();
+    out.push_back('[');
+    depth++;
+    hasItems &= ~(1ULL << depth);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    depth--;
+    out.push_back(']');
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(string_view name) {
+    value(name);
+    out.push_back(':');
+    afterKey = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(string_view text) {
+    static const char HEX[] = "0123456789abcdef";
+    separate();
+    out.push_back('"');
+    size_t plain = 0;   // Start of the run of characters that need no escaping
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(text.data() + plain, i - plain);
+        plain = i + 1;
+        switch (c) {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default:
+                out.append("\\u00");
+                out.push_back(HEX[c >> 4]);
+                out.push_back(HEX[c & 0xF]);
+        }
+    }
+    out.append(text.data() + plain, text.size() - plain);
+    out.push_back('"');
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number) {
+    if (!isfinite(number)) {
+        return null();
+    }
+    separate();
+    char buffer[32];
+    to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), number);
+    out.append(buffer, result.ptr - buffer);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(int64_t number) {
+    separate();
+    char buffer[24];
+    to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), number);
+    out.append(buffer, result.ptr - buffer);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    separate();
+    out.append(flag ? "true" : "false");
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(Date date) {
+    if (!date.isValid()) {
+        return null();
+    }
+    separate();
+    char buffer[12];
+    buffer[0] = '"';
+    size_t length = date.format(buffer + 1);
+    buffer[length + 1] = '"';
+    out.append(buffer, length + 2);
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    separate();
+    out.append("null");
+    return *this;
+}
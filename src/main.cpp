@@ -17,21 +17,121 @@
 #include "auth.h"
 #include "booking.h"
 
+#ifdef __linux__
+#include <csignal>
+#include <cstdlib>
+#include "booking_server.h"
+#include "http_server.h"
+#endif
+
 using namespace std;
 
+#ifdef __linux__
+static EventLoop* activeLoop = nullptr;
+
+static void stopServer(int) {
+    if (activeLoop) {
+        activeLoop->stop();
+    }
+}
+
+/**
+ * Runs the network servers until SIGINT or SIGTERM
+ * 
+ * Both servers share one event loop and one set of data: the binary
+ * protocol (see protocol.h) on a Unix domain socket and the HTTP/1.1 JSON
+ * API (see http_server.h) on TCP. Data files are saved on the way out, as
+ * when the console application exits.
+ * 
+ * @param socketPath Unix domain socket for the binary protocol, empty for none
+ * @param httpAddress host:port or port for the HTTP API, empty for none
+ * @return 0 after a clean shutdown, 1 if data/ is in use by another program
+ *         or a listener could not be opened
+ */
+static int runServer(const string& socketPath, const string& httpAddress) {
+    Auth auth;
+    BookingManager bookingManager;
+    if (!auth.hasDataLock() || !bookingManager.hasDataLock()) {
+        return 1; // Another process is using data/
+    }
+    EventLoop loop;
+    BookingServer bookingServer(loop, auth, bookingManager);
+    HttpServer httpServer(loop, auth, bookingManager);
+    
+    if (!socketPath.empty()) {
+        if (!bookingServer.listenUnix(socketPath)) {
+            return 1;
+        }
+        cout << "Booking server listening on " << socketPath << endl;
+    }
+    if (!httpAddress.empty()) {
+        size_t colon = httpAddress.rfind(':');
+        string host = colon == string::npos ? "127.0.0.1" : httpAddress.substr(0, colon);
+        int port = atoi(httpAddress.c_str() + (colon == string::npos ? 0 : colon + 1));
+        if (port <= 0 || port > 65535 || !httpServer.listenTcp(host, static_cast<uint16_t>(port))) {
+            cout << "Cannot serve HTTP on " << httpAddress << endl;
+            return 1;
+        }
+        cout << "HTTP API listening on " << host << ":" << port << endl;
+    }
+    
+    activeLoop = &loop;
+    signal(SIGINT, stopServer);
+    signal(SIGTERM, stopServer);
+    cout << "Press Ctrl+C to stop." << endl;
+    loop.run();
+    activeLoop = nullptr;
+    
+    SocketServer::Stats binary = bookingServer.getStats();
+    SocketServer::Stats http = httpServer.getStats();
+    cout << "Server stopped after " << binary.requests + http.requests << " requests from "
+         << binary.accepted + http.accepted << " connections." << endl;
+    return 0;
+}
+#endif
+
 /**
  * Main function - Application entry point
  * 
  * Initializes the application components and runs the main program loop.
  * Handles user authentication, menu navigation, and application flow.
+ * With --server [socket] and/or --http [host:]port, runs the network
+ * servers instead.
  * 
  * @return 0 on successful execution
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && (string(argv[1]) == "--server" || string(argv[1]) == "--http")) {
+#ifdef __linux__
+        // --server [socket] and/or --http [host:]port
+        string socketPath;
+        string httpAddress;
+        for (int i = 1; i < argc; i++) {
+            string option = argv[i];
+            bool hasValue = i + 1 < argc && argv[i + 1][0] != '-';
+            if (option == "--server") {
+                socketPath = hasValue ? argv[++i] : "data/server.sock";
+            } else if (option == "--http") {
+                httpAddress = hasValue ? argv[++i] : "8080";
+            } else {
+                cout << "Usage: " << argv[0] << " [--server [socket]] [--http [host:]port]" << endl;
+                return 1;
+            }
+        }
+        return runServer(socketPath, httpAddress);
+#else
+        cout << "Server mode is only available on Linux." << endl;
+        return 1;
+#endif
+    }
+    
     // Initialize application components
     UI ui;                    // User interface handler
     Auth auth;                // Authentication system
     BookingManager bookingManager;  // Booking and motorbike management
+    if (!auth.hasDataLock() || !bookingManager.hasDataLock()) {
+        return 1; // Another process is using data/
+    }
     
     // Set up component references for cross-class communication
     ui.setAuth(&auth);
@@ -50,17 +150,17 @@ int main() {
                 ui.showGuestMenu();
                 break;
             case 2: // Member login
-                if (auth.login()) {
+                if (ui.memberLogin()) {
                     ui.showMemberMenu();
                 }
                 break;
             case 3: // Admin login
-                if (auth.adminLogin()) {
+                if (ui.adminLogin()) {
                     ui.showAdminMenu();
                 }
                 break;
             case 4: // New member registration
-                auth.registerUser();
+                ui.registerUser();
                 break;
             case 5: // Exit application
                 cout << "\nThank you for using E-MOTORBIKE RENTAL APPLICATION!\n";
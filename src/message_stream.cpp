@@ -0,0 +1,31 @@
+#include "message_stream.h"
+#include <iostream>
+
+using namespace std;
+
+// ============================================================================
+// ENGINE MESSAGE STREAM
+// ============================================================================
+
+namespace {
+
+ostream* current = &cout;
+thread_local ostream* threadCurrent = nullptr;
+
+} // namespace
+
+ostream& messageStream() {
+    return threadCurrent ? *threadCurrent : *current;
+}
+
+void setMessageStream(ostream& stream) {
+    current = &stream;
+}
+
+ostream* threadMessageStream() {
+    return threadCurrent;
+}
+
+void setThreadMessageStream(ostream* stream) {
+    threadCurrent = stream;
+}
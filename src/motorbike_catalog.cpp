@@ -0,0 +1,227 @@
+#include "motorbike_catalog.h"
+#include "booking.h"
+#include <algorithm>
+
+#ifdef EMR_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// ============================================================================
+// MOTORBIKE CATALOG IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+// Mask of bits [first, last] within one 64-bit word
+uint64_t bitRange(int32_t first, int32_t last) {
+    uint64_t upper = last == 63 ? ~0ULL : (1ULL << (last + 1)) - 1;
+    return upper & ~((1ULL << first) - 1);
+}
+
+} // namespace
+
+// Clones the row's block first if a copy of the catalog still shares it
+MotorbikeCatalog::Block& MotorbikeCatalog::writableBlock(size_t row) {
+    shared_ptr<Block>& block = blocks[row >> BLOCK_BITS];
+    if (block.use_count() > 1) {
+        block = make_shared<Block>(*block);
+    }
+    return *block;
+}
+
+bool MotorbikeCatalog::set(size_t row, const Motorbike& motorbike) {
+    bool added = row == rows;
+    if (added && rowInBlock(row) == 0) {
+        blocks.push_back(make_shared<Block>());
+    }
+    Block& block = writableBlock(row);
+    size_t i = rowInBlock(row);
+    if (added) {
+        block.keys.push_back(0);
+        block.prices.push_back(0.0);
+        block.minRenterRatings.push_back(0.0);
+        block.engineCcs.push_back(0);
+        block.startDays.push_back(0);
+        block.endDays.push_back(0);
+        block.occupancyOffsets.push_back(0);
+        block.occupancyLengths.push_back(0);
+        rows++;
+    }
+    int32_t startDay = motorbike.getAvailableStart().dayNumber();
+    int32_t endDay = motorbike.getAvailableEnd().dayNumber();
+    bool reset = added || block.startDays[i] != startDay || block.endDays[i] != endDay;
+    if (reset) {
+        size_t days = motorbike.getAvailableStart().isValid() && motorbike.getAvailableEnd().isValid() &&
+                      endDay >= startDay ? static_cast<size_t>(endDay - startDay) + 1 : 0;
+        uint32_t words = static_cast<uint32_t>((days + 63) / 64);
+        if (words > block.occupancyLengths[i]) {
+            // Windows rarely change, so a grown row simply moves to the end of the arena
+            block.occupancyOffsets[i] = static_cast<uint32_t>(block.occupancyWords.size());
+            block.occupancyWords.resize(block.occupancyWords.size() + words);
+        }
+        block.occupancyLengths[i] = words;
+        fill_n(block.occupancyWords.begin() + block.occupancyOffsets[i], words, 0);
+    }
+    block.keys[i] = motorbike.getLocationId() << 2 | (motorbike.getIsListed() ? LISTED : 0) |
+                    (motorbike.getIsAvailable() ? AVAILABLE : 0);
+    block.prices[i] = motorbike.getPricePerDay();
+    block.minRenterRatings[i] = motorbike.getMinRenterRating();
+    block.engineCcs[i] = motorbike.getEngineSize();
+    block.startDays[i] = startDay;
+    block.endDays[i] = endDay;
+    return reset;
+}
+
+void MotorbikeCatalog::reserve(size_t rows) {
+    blocks.reserve((rows + BLOCK_ROWS - 1) >> BLOCK_BITS);
+}
+
+// Converts [firstDay, lastDay] to bit positions in the row's occupancy words;
+// false if the range misses the availability window entirely
+bool MotorbikeCatalog::Block::clipToWindow(size_t row, int32_t& first, int32_t& last) const {
+    if (occupancyLengths[row] == 0 || endDays[row] < first || last < startDays[row]) {
+        return false;
+    }
+    first = max(first, startDays[row]) - startDays[row];
+    last = min(last, endDays[row]) - startDays[row];
+    return true;
+}
+
+void MotorbikeCatalog::setOccupied(size_t row, int32_t firstDay, int32_t lastDay, bool occupied) {
+    if (!blockOf(row).clipToWindow(rowInBlock(row), firstDay, lastDay)) {
+        return;
+    }
+    Block& block = writableBlock(row);
+    uint64_t* words = block.occupancyWords.data() + block.occupancyOffsets[rowInBlock(row)];
+    for (int32_t word = firstDay / 64; word <= lastDay / 64; word++) {
+        uint64_t mask = bitRange(word == firstDay / 64 ? firstDay % 64 : 0, word == lastDay / 64 ? lastDay % 64 : 63);
+        words[word] = occupied ? words[word] | mask : words[word] & ~mask;
+    }
+}
+
+void MotorbikeCatalog::clearOccupancy(size_t row) {
+    Block& block = writableBlock(row);
+    size_t i = rowInBlock(row);
+    fill_n(block.occupancyWords.begin() + block.occupancyOffsets[i], block.occupancyLengths[i], 0);
+}
+
+bool MotorbikeCatalog::Block::isFree(size_t row, int32_t firstDay, int32_t lastDay) const {
+    if (!clipToWindow(row, firstDay, lastDay)) {
+        return true;
+    }
+    const uint64_t* words = occupancyWords.data() + occupancyOffsets[row];
+    for (int32_t word = firstDay / 64; word <= lastDay / 64; word++) {
+        uint64_t mask = bitRange(word == firstDay / 64 ? firstDay % 64 : 0, word == lastDay / 64 ? lastDay % 64 : 63);
+        if (words[word] & mask) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Clears the bits of mask (rows row .. row + 7) whose motorbike is booked in the range
+unsigned MotorbikeCatalog::Block::freeRows(size_t row, unsigned mask, int32_t firstDay, int32_t lastDay) const {
+    for (unsigned bits = mask; bits; bits &= bits - 1) {
+        unsigned lane = __builtin_ctz(bits);
+        if (!isFree(row + lane, firstDay, lastDay)) {
+            mask &= ~(1u << lane);
+        }
+    }
+    return mask;
+}
+
+bool MotorbikeCatalog::usesAVX2() {
+#ifdef EMR_AVX2_KERNEL
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+size_t MotorbikeCatalog::select(const CatalogQuery& query, vector<uint64_t>& selection) const {
+    selection.assign((rows + 63) / 64, 0);
+    bool avx2 = usesAVX2();
+    for (size_t index = 0; index < blocks.size(); index++) {
+        uint64_t* words = selection.data() + index * (BLOCK_ROWS / 64);
+        size_t first = 0;
+#ifdef EMR_AVX2_KERNEL
+        if (avx2) {
+            first = blocks[index]->selectAVX2(query, words);
+        }
+#endif
+        blocks[index]->selectScalar(query, first, words);
+    }
+
+    size_t matches = 0;
+    for (uint64_t word : selection) {
+        matches += __builtin_popcountll(word);
+    }
+    return matches;
+}
+
+// Handles rows [first, keys.size()) of the block; the AVX2 kernel leaves it the tail
+void MotorbikeCatalog::Block::selectScalar(const CatalogQuery& query, size_t first, uint64_t* words) const {
+    uint32_t key = query.cityId << 2 | LISTED | AVAILABLE;
+    for (size_t row = first; row < keys.size(); row++) {
+        bool match = keys[row] == key &&
+                     startDays[row] <= query.startDay &&
+                     query.endDay <= endDays[row] &&
+                     engineCcs[row] <= query.maxEngineCc &&
+                     minRenterRatings[row] <= query.renterRating &&
+                     prices[row] * query.rentalDays <= query.renterCredits &&
+                     (!query.requireFree || isFree(row, query.startDay, query.endDay));
+        words[row / 64] |= static_cast<uint64_t>(match) << (row % 64);
+    }
+}
+
+#ifdef EMR_AVX2_KERNEL
+// Evaluates eight rows per step: integer columns in one 8 x int32 register,
+// double columns in two 4 x double halves, combined into one mask byte.
+// Compiled for AVX2 whatever the build flags; call only if usesAVX2().
+__attribute__((target("avx2")))
+size_t MotorbikeCatalog::Block::selectAVX2(const CatalogQuery& query, uint64_t* words) const {
+    const __m256i key = _mm256_set1_epi32(static_cast<int32_t>(query.cityId << 2 | LISTED | AVAILABLE));
+    const __m256i startDay = _mm256_set1_epi32(query.startDay);
+    const __m256i endDay = _mm256_set1_epi32(query.endDay);
+    const __m256i maxEngineCc = _mm256_set1_epi32(query.maxEngineCc);
+    const __m256d renterRating = _mm256_set1_pd(query.renterRating);
+    const __m256d renterCredits = _mm256_set1_pd(query.renterCredits);
+    const __m256d rentalDays = _mm256_set1_pd(query.rentalDays);
+
+    size_t rows = keys.size() & ~static_cast<size_t>(7);
+    for (size_t row = 0; row < rows; row += 8) {
+        __m256i ok = _mm256_cmpeq_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys.data() + row)), key);
+        // a <= b is computed as not (a > b)
+        ok = _mm256_andnot_si256(_mm256_cmpgt_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(startDays.data() + row)), startDay), ok);
+        ok = _mm256_andnot_si256(_mm256_cmpgt_epi32(endDay,
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(endDays.data() + row))), ok);
+        ok = _mm256_andnot_si256(_mm256_cmpgt_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(engineCcs.data() + row)), maxEngineCc), ok);
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(ok)));
+        if (mask == 0) {
+            continue;
+        }
+
+        unsigned priced = 0;
+        for (size_t half = 0; half < 2; half++) {
+            size_t base = row + half * 4;
+            __m256d rating = _mm256_cmp_pd(_mm256_loadu_pd(minRenterRatings.data() + base),
+                                           renterRating, _CMP_LE_OQ);
+            __m256d cost = _mm256_cmp_pd(_mm256_mul_pd(_mm256_loadu_pd(prices.data() + base), rentalDays),
+                                         renterCredits, _CMP_LE_OQ);
+            priced |= static_cast<unsigned>(_mm256_movemask_pd(_mm256_and_pd(rating, cost))) << (half * 4);
+        }
+        mask &= priced;
+        if (query.requireFree && mask) {
+            mask = freeRows(row, mask, query.startDay, query.endDay);
+        }
+        words[row / 64] |= static_cast<uint64_t>(mask) << (row % 64);
+    }
+    return rows;
+}
+#endif
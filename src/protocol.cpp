@@ -0,0 +1,124 @@
+#include "protocol.h"
+#include <cstring>
+
+using namespace std;
+
+// ============================================================================
+// FRAME WRITER IMPLEMENTATION
+// ============================================================================
+
+FrameWriter::FrameWriter(string& buffer) : buffer(buffer), start(buffer.size()) {
+    buffer.append(FRAME_HEADER_SIZE, '\0');
+}
+
+FrameWriter& FrameWriter::u8(uint8_t value) {
+    buffer.push_back(static_cast<char>(value));
+    return *this;
+}
+
+FrameWriter& FrameWriter::u16(uint16_t value) {
+    buffer.push_back(static_cast<char>(value & 0xFF));
+    buffer.push_back(static_cast<char>(value >> 8));
+    return *this;
+}
+
+FrameWriter& FrameWriter::u32(uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        buffer.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+    return *this;
+}
+
+FrameWriter& FrameWriter::f64(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    u32(static_cast<uint32_t>(bits));
+    return u32(static_cast<uint32_t>(bits >> 32));
+}
+
+FrameWriter& FrameWriter::str(string_view value) {
+    if (value.size() > 0xFFFF) {
+        value = value.substr(0, 0xFFFF);
+    }
+    u16(static_cast<uint16_t>(value.size()));
+    buffer.append(value.data(), value.size());
+    return *this;
+}
+
+void FrameWriter::finish() {
+    uint32_t length = static_cast<uint32_t>(buffer.size() - start - FRAME_HEADER_SIZE);
+    for (size_t i = 0; i < FRAME_HEADER_SIZE; i++) {
+        buffer[start + i] = static_cast<char>((length >> (i * 8)) & 0xFF);
+    }
+}
+
+// ============================================================================
+// FRAME READER IMPLEMENTATION
+// ============================================================================
+
+FrameReader::FrameReader(string_view payload)
+    : data(payload.data()), size(payload.size()), position(0), valid(true) {
+}
+
+bool FrameReader::take(size_t bytes) {
+    if (!valid || size - position < bytes) {
+        valid = false;
+        return false;
+    }
+    return true;
+}
+
+uint8_t FrameReader::u8() {
+    if (!take(1)) {
+        return 0;
+    }
+    return static_cast<uint8_t>(data[position++]);
+}
+
+uint16_t FrameReader::u16() {
+    if (!take(2)) {
+        return 0;
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data + position);
+    position += 2;
+    return static_cast<uint16_t>(bytes[0] | bytes[1] << 8);
+}
+
+uint32_t FrameReader::u32() {
+    if (!take(4)) {
+        return 0;
+    }
+    uint32_t value = frameLength(data + position, 4);
+    position += 4;
+    return value;
+}
+
+double FrameReader::f64() {
+    uint64_t low = u32();
+    uint64_t bits = low | static_cast<uint64_t>(u32()) << 32;
+    if (!valid) {
+        return 0.0;
+    }
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+string_view FrameReader::str() {
+    uint16_t length = u16();
+    if (!take(length)) {
+        return string_view();
+    }
+    string_view value(data + position, length);
+    position += length;
+    return value;
+}
+
+uint32_t frameLength(const char* data, size_t available) {
+    if (available < FRAME_HEADER_SIZE) {
+        return 0;
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+           static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+}
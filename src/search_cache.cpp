@@ -0,0 +1,67 @@
+#include "search_cache.h"
+
+using namespace std;
+
+// ============================================================================
+// SEARCH CACHE IMPLEMENTATION
+// ============================================================================
+
+const vector<uint32_t>* SearchCache::find(const Key& key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        stats.misses++;
+        return nullptr;
+    }
+    stats.hits++;
+    entries.splice(entries.begin(), entries, it->second);
+    return &it->second->slots;
+}
+
+const vector<uint32_t>* SearchCache::insert(const Key& key, vector<uint32_t> slots) {
+    auto existing = index.find(key);
+    if (existing != index.end()) {
+        erase(existing->second);
+    }
+    if (slots.size() > MAX_SLOTS) {
+        return nullptr; // Would evict everything else; not worth caching
+    }
+
+    slotCount += slots.size();
+    entries.push_front({key, move(slots)});
+    index[key] = entries.begin();
+    while (entries.size() > MAX_ENTRIES || slotCount > MAX_SLOTS) {
+        erase(prev(entries.end()));
+        stats.evictions++;
+    }
+    return &entries.front().slots;
+}
+
+void SearchCache::invalidate(uint32_t cityId, int32_t startDay, int32_t endDay) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        const Key& key = it->key;
+        if (key.cityId == cityId && startDay <= key.startDay && key.endDay <= endDay) {
+            erase(it++);
+            stats.invalidations++;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void SearchCache::clear() {
+    entries.clear();
+    index.clear();
+    slotCount = 0;
+}
+
+SearchCache::Stats SearchCache::getStats() const {
+    Stats current = stats;
+    current.entries = entries.size();
+    return current;
+}
+
+void SearchCache::erase(list<Entry>::iterator it) {
+    slotCount -= it->slots.size();
+    index.erase(it->key);
+    entries.erase(it);
+}
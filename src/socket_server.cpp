@@ -0,0 +1,312 @@
+#include "socket_server.h"
+
+#ifdef __linux__
+#include "message_stream.h"
+#include <cerrno>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+// ============================================================================
+// SOCKET SERVER IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+const size_t READ_CHUNK = 16 * 1024;
+const int READS_PER_EVENT = 4;                  // Then yield to other connections
+const size_t MAX_BUFFERED_OUTPUT = 1024 * 1024; // Stop handling requests beyond this
+
+bool fillAddress(const string& path, sockaddr_un& address) {
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+// True if a server is accepting connections on path
+bool isSocketInUse(const sockaddr_un& address) {
+    int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe < 0) {
+        return false;
+    }
+    bool inUse = connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    close(probe);
+    return inUse;
+}
+
+// Thousands of clients need more descriptors than the usual soft limit of 1024
+void raiseDescriptorLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+} // namespace
+
+SocketServer::SocketServer(EventLoop& loop) : loop(loop), listenFd(-1), acceptPaused(false) {
+}
+
+SocketServer::~SocketServer() {
+    for (auto& entry : connections) {
+        loop.remove(entry.first);
+        close(entry.first);
+    }
+    if (listenFd >= 0) {
+        loop.remove(listenFd);
+        close(listenFd);
+        if (!socketPath.empty()) {
+            unlink(socketPath.c_str());
+        }
+    }
+}
+
+SocketServer::Stats SocketServer::getStats() const {
+    Stats current = stats;
+    current.connections = connections.size();
+    return current;
+}
+
+bool SocketServer::listenUnix(const string& path) {
+    sockaddr_un address;
+    if (listenFd >= 0 || !loop.isValid() || !fillAddress(path, address)) {
+        messageStream() << "Invalid server socket path: " << path << endl;
+        return false;
+    }
+    struct stat existing;
+    if (stat(path.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode) || isSocketInUse(address)) {
+            messageStream() << "Another server is already using " << path << "." << endl;
+            return false;
+        }
+        unlink(path.c_str());  // Left behind by a server that did not shut down cleanly
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 || bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        messageStream() << "Cannot listen on " << path << ": " << strerror(errno) << endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    socketPath = path;
+    return startListening(fd);
+}
+
+bool SocketServer::listenTcp(const string& host, uint16_t port) {
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (listenFd >= 0 || !loop.isValid() || inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        messageStream() << "Invalid server address: " << host << endl;
+        return false;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int reuse = 1;
+    if (fd < 0 || setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+        bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        messageStream() << "Cannot listen on " << host << ":" << port << ": " << strerror(errno) << endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    return startListening(fd);
+}
+
+bool SocketServer::startListening(int fd) {
+    if (::listen(fd, SOMAXCONN) != 0 || !loop.add(fd, EPOLLIN, [this](uint32_t) { acceptConnections(); })) {
+        messageStream() << "Cannot listen: " << strerror(errno) << endl;
+        close(fd);
+        if (!socketPath.empty()) {
+            unlink(socketPath.c_str());
+            socketPath.clear();
+        }
+        return false;
+    }
+    listenFd = fd;
+    raiseDescriptorLimit();
+    return true;
+}
+
+// ============================================================================
+// CONNECTION I/O
+// ============================================================================
+
+void SocketServer::acceptConnections() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (errno == EMFILE || errno == ENFILE) {
+                // The backlog keeps the client until a descriptor frees up
+                acceptPaused = true;
+                loop.modify(listenFd, 0);
+            }
+            return;
+        }
+        if (socketPath.empty()) {
+            // Pipelined responses are small; send each as soon as it is ready
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        }
+        unique_ptr<Connection> connection(new Connection());
+        connection->fd = fd;
+        connection->events = EPOLLIN;
+        if (!loop.add(fd, EPOLLIN, [this, fd](uint32_t events) { onConnectionEvent(fd, events); })) {
+            close(fd);
+            continue;
+        }
+        connections[fd] = move(connection);
+        stats.accepted++;
+    }
+}
+
+void SocketServer::onConnectionEvent(int fd, uint32_t events) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) {
+        return;
+    }
+    Connection& connection = *it->second;
+    if (events & EPOLLERR) {
+        closeConnection(fd);
+        return;
+    }
+    if ((events & EPOLLOUT) && !flushOutput(connection)) {
+        closeConnection(fd);
+        return;
+    }
+    if ((events & (EPOLLIN | EPOLLHUP)) && !connection.closing && !readInput(connection)) {
+        closeConnection(fd);
+        return;
+    }
+    // Requests held back by the backlog limit run as soon as the backlog is sent
+    bool heldBack;
+    do {
+        {
+            ScopedMessageStream capture(messages);
+            connection.input.erase(0, handleInput(connection));
+        }
+        heldBack = !connection.closing && !connection.input.empty() && backlogFull(connection);
+        if (!flushOutput(connection)) {
+            closeConnection(fd);
+            return;
+        }
+    } while (heldBack && connection.output.empty());
+    if (connection.closing && connection.output.empty()) {
+        closeConnection(fd);
+        return;
+    }
+    updateEvents(connection);
+}
+
+// False on a read error; end of stream sets closing
+bool SocketServer::readInput(Connection& connection) {
+    char chunk[READ_CHUNK];
+    for (int reads = 0; reads < READS_PER_EVENT; reads++) {
+        ssize_t received = recv(connection.fd, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            connection.input.append(chunk, static_cast<size_t>(received));
+            if (static_cast<size_t>(received) < sizeof(chunk)) {
+                return true;
+            }
+        } else if (received == 0) {
+            connection.closing = true;
+            return true;
+        } else if (errno == EINTR) {
+            reads--;
+        } else {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+    }
+    return true;
+}
+
+// False on a send error
+bool SocketServer::flushOutput(Connection& connection) {
+    while (connection.sent < connection.output.size()) {
+        ssize_t written = send(connection.fd, connection.output.data() + connection.sent,
+                               connection.output.size() - connection.sent, MSG_NOSIGNAL);
+        if (written > 0) {
+            connection.sent += static_cast<size_t>(written);
+        } else if (written < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+    }
+    connection.output.clear();
+    connection.sent = 0;
+    return true;
+}
+
+// Reads only while the backlog is small, and waits for EPOLLOUT while any remains
+void SocketServer::updateEvents(Connection& connection) {
+    size_t backlog = connection.output.size() - connection.sent;
+    uint32_t events = 0;
+    if (!connection.closing && backlog < MAX_BUFFERED_OUTPUT) {
+        events |= EPOLLIN;
+    }
+    if (backlog > 0) {
+        events |= EPOLLOUT;
+    }
+    if (events != connection.events) {
+        loop.modify(connection.fd, events);
+        connection.events = events;
+    }
+}
+
+void SocketServer::closeConnection(int fd) {
+    loop.remove(fd);
+    connections.erase(fd);
+    close(fd);
+    if (acceptPaused) {
+        acceptPaused = false;
+        loop.modify(listenFd, EPOLLIN);
+    }
+}
+
+bool SocketServer::backlogFull(const Connection& connection) const {
+    return connection.output.size() - connection.sent >= MAX_BUFFERED_OUTPUT;
+}
+
+void SocketServer::beginRequest() {
+    stats.requests++;
+    discardMessages();
+}
+
+void SocketServer::discardMessages() {
+    messages.str("");
+    messages.clear();
+}
+
+string SocketServer::lastMessage() const {
+    string text = messages.str();
+    size_t end = text.find_last_not_of(" \r\n");
+    if (end == string::npos) {
+        return "";
+    }
+    size_t start = text.find_last_of('\n', end);
+    start = start == string::npos ? 0 : start + 1;
+    return text.substr(start, end - start + 1);
+}
+
+#endif
@@ -0,0 +1,57 @@
+#include "statistics.h"
+#include "auth.h"
+#include "booking.h"
+
+using namespace std;
+
+// ============================================================================
+// SYSTEM STATISTICS
+// ============================================================================
+
+SystemStatistics collectStatistics(const Auth& auth, const BookingManager& bookingManager) {
+    SystemStatistics statistics;
+    
+    double memberRatings = 0.0;
+    for (const User& user : auth.viewUsers()) {
+        statistics.totalUsers++;
+        if (user.isMember()) {
+            statistics.members++;
+            statistics.totalCreditPoints += user.getCreditPoints();
+            memberRatings += user.getRating();
+        } else if (user.isAdmin()) {
+            statistics.admins++;
+        }
+    }
+    if (statistics.members > 0) {
+        statistics.averageMemberRating = memberRatings / statistics.members;
+    }
+    
+    double motorbikeRatings = 0.0;
+    for (const Motorbike& motorbike : bookingManager.viewMotorbikes()) {
+        statistics.totalMotorbikes++;
+        if (motorbike.getIsListed()) {
+            statistics.listedMotorbikes++;
+            statistics.totalDailyValue += motorbike.getPricePerDay();
+        }
+        if (motorbike.getIsAvailable()) {
+            statistics.availableMotorbikes++;
+        }
+        motorbikeRatings += motorbike.getRating();
+    }
+    if (statistics.totalMotorbikes > 0) {
+        statistics.averageMotorbikeRating = motorbikeRatings / statistics.totalMotorbikes;
+    }
+    
+    for (const Booking& booking : bookingManager.viewBookings()) {
+        statistics.totalBookings++;
+        if (booking.isPending()) statistics.pendingBookings++;
+        else if (booking.isApproved()) statistics.approvedBookings++;
+        else if (booking.isCompleted()) statistics.completedBookings++;
+        else if (booking.isRejected()) statistics.rejectedBookings++;
+        
+        statistics.totalBookingValue += booking.getTotalCost();
+    }
+    
+    statistics.searchCache = bookingManager.getSearchCacheStats();
+    return statistics;
+}
@@ -0,0 +1,30 @@
+#include "string_pool.h"
+
+using namespace std;
+
+uint32_t StringPool::intern(string_view value) {
+    auto it = ids.find(value);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    uint32_t id = count;
+    int segment = segmentOf(id);
+    if (!segments[segment]) {
+        segments[segment].reset(new string[FIRST_SEGMENT << segment]);
+    }
+    string& stored = segments[segment][offsetOf(id, segment)];
+    stored.assign(value.data(), value.size());
+    ids.emplace(string_view(stored), id);
+    count++;
+    return id;
+}
+
+uint32_t StringPool::find(string_view value) const {
+    auto it = ids.find(value);
+    return it != ids.end() ? it->second : NOT_FOUND;
+}
+
+StringPool& fieldPool() {
+    static StringPool pool;
+    return pool;
+}
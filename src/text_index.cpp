@@ -0,0 +1,105 @@
+#include "text_index.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+using namespace std;
+
+// ============================================================================
+// TEXT INDEX IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+const double SATURATION = 1.2;  // BM25 k1: how quickly repeated words stop adding score
+
+bool isWordByte(unsigned char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+}
+
+} // namespace
+
+void TextIndex::tokenize(string_view text, vector<string>& tokens) {
+    tokens.clear();
+    size_t pos = 0;
+    while (pos < text.size()) {
+        while (pos < text.size() && !isWordByte(text[pos])) pos++;
+        size_t start = pos;
+        while (pos < text.size() && isWordByte(text[pos])) pos++;
+        if (pos > start) {
+            string token(text.substr(start, pos - start));
+            for (char& c : token) {
+                if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+            }
+            tokens.push_back(move(token));
+        }
+    }
+}
+
+void TextIndex::add(uint32_t document, string_view text, float weight) {
+    vector<string> tokens;
+    tokenize(text, tokens);
+    for (string& token : tokens) {
+        vector<Posting>& list = postings[move(token)];
+        if (!list.empty() && list.back().document == document) {
+            list.back().weight += weight;
+        } else if (list.empty() || list.back().document < document) {
+            list.push_back({document, weight});
+        } else {
+            // Text added to an older document, e.g. a new review
+            auto it = lower_bound(list.begin(), list.end(), document,
+                                  [](const Posting& posting, uint32_t id) { return posting.document < id; });
+            if (it != list.end() && it->document == document) {
+                it->weight += weight;
+            } else {
+                list.insert(it, {document, weight});
+            }
+        }
+    }
+    documentCount = max(documentCount, static_cast<size_t>(document) + 1);
+}
+
+vector<TextIndex::Match> TextIndex::search(string_view query, size_t limit, const Filter& accept) const {
+    vector<string> tokens;
+    tokenize(query, tokens);
+    sort(tokens.begin(), tokens.end());
+    tokens.erase(unique(tokens.begin(), tokens.end()), tokens.end());
+
+    unordered_map<uint32_t, double> scores;
+    for (const string& token : tokens) {
+        for (auto it = postings.lower_bound(token); it != postings.end(); ++it) {
+            const string& term = it->first;
+            bool exact = term.size() == token.size();
+            if (term.compare(0, token.size(), token) != 0 || (!exact && token.size() < PREFIX_MIN_LENGTH)) {
+                break;
+            }
+
+            double frequency = static_cast<double>(it->second.size());
+            double idf = log(1.0 + (documentCount - frequency + 0.5) / (frequency + 0.5));
+            if (!exact) {
+                idf *= PREFIX_WEIGHT;
+            }
+            for (const Posting& posting : it->second) {
+                scores[posting.document] += idf * posting.weight * (SATURATION + 1) / (posting.weight + SATURATION);
+            }
+        }
+    }
+
+    vector<Match> matches;
+    matches.reserve(scores.size());
+    for (const auto& entry : scores) {
+        if (!accept || accept(entry.first)) {
+            matches.push_back({entry.first, entry.second});
+        }
+    }
+    auto better = [](const Match& a, const Match& b) {
+        return a.score > b.score || (a.score == b.score && a.document < b.document);
+    };
+    if (matches.size() > limit) {
+        partial_sort(matches.begin(), matches.begin() + limit, matches.end(), better);
+        matches.resize(limit);
+    } else {
+        sort(matches.begin(), matches.end(), better);
+    }
+    return matches;
+}
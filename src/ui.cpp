@@ -18,6 +18,7 @@
 #include "ui_admin.h"
 #include "ui_guest.h"
 #include "ui_dashboard.h"
+#include "ui_auth.h"
 #include "auth.h"
 #include "booking.h"
 
@@ -27,7 +28,7 @@
 UI::UI() : auth(nullptr), bookingManager(nullptr),
            uiCore(nullptr), uiProfile(nullptr), uiMotorbike(nullptr),
            uiBooking(nullptr), uiAdmin(nullptr), uiGuest(nullptr), 
-           uiDashboard(nullptr) {
+           uiDashboard(nullptr), uiAuth(nullptr) {
     initializeUIModules();
 }
 
@@ -42,6 +43,7 @@ UI::~UI() {
     delete uiAdmin;
     delete uiGuest;
     delete uiDashboard;
+    delete uiAuth;
 }
 
 /**
@@ -55,6 +57,7 @@ void UI::initializeUIModules() {
     uiAdmin = new UIAdmin();
     uiGuest = new UIGuest();
     uiDashboard = new UIDashboard();
+    uiAuth = new UIAuth();
 }
 
 /**
@@ -62,7 +65,7 @@ void UI::initializeUIModules() {
  */
 void UI::setupModuleReferences() {
     if (!uiCore || !uiProfile || !uiMotorbike || !uiBooking || 
-        !uiAdmin || !uiGuest || !uiDashboard) {
+        !uiAdmin || !uiGuest || !uiDashboard || !uiAuth) {
         return; // Safety check
     }
 
@@ -96,6 +99,8 @@ void UI::setupModuleReferences() {
     uiDashboard->setUIMotorbike(uiMotorbike);
     uiDashboard->setUIBooking(uiBooking);
     
+    uiAuth->setAuth(auth);
+    
     // Set UI module references in UICore
     uiCore->setUIProfile(uiProfile);
     uiCore->setUIMotorbike(uiMotorbike);
@@ -166,3 +171,24 @@ void UI::showAdminMenu() {
         uiCore->showAdminMenu();
     }
 }
+
+/**
+ * Prompt for member credentials and log in - delegates to UIAuth
+ */
+bool UI::memberLogin() {
+    return uiAuth && uiAuth->memberLogin();
+}
+
+/**
+ * Prompt for admin credentials and log in - delegates to UIAuth
+ */
+bool UI::adminLogin() {
+    return uiAuth && uiAuth->adminLogin();
+}
+
+/**
+ * Prompt for registration details and register - delegates to UIAuth
+ */
+bool UI::registerUser() {
+    return uiAuth && uiAuth->registerUser();
+}
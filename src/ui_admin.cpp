@@ -14,6 +14,7 @@
 #include "ui_core.h"
 #include "auth.h"
 #include "booking.h"
+#include "statistics.h"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -48,7 +49,7 @@ void UIAdmin::viewAllMemberProfiles() {
     uiCore->clearScreen();
     cout << "=== ALL MEMBER PROFILES ===\n\n";
     
-    vector<User> allUsers = auth->getAllUsers();
+    RecordSpan<deque<User>> allUsers = auth->viewUsers();
     
     if (allUsers.empty()) {
         cout << "No users found in the system.\n";
@@ -80,9 +81,9 @@ void UIAdmin::viewAllMemberProfiles() {
              << setw(8) << fixed << setprecision(1) << user.getRating() << " | "
              << setw(12) << user.getLicenseExpiry() << "\n";
         
-        if (user.getRole() == "member") {
+        if (user.isMember()) {
             memberCount++;
-        } else if (user.getRole() == "admin") {
+        } else if (user.isAdmin()) {
             adminCount++;
         }
     }
@@ -109,7 +110,7 @@ void UIAdmin::viewAllMotorbikeListings() {
     uiCore->clearScreen();
     cout << "=== ALL MOTORBIKE LISTINGS ===\n\n";
     
-    vector<Motorbike> allMotorbikes = bookingManager->getAllMotorbikes();
+    RecordSpan<CowTable<Motorbike>> allMotorbikes = bookingManager->viewMotorbikes();
     
     if (allMotorbikes.empty()) {
         cout << "No motorbikes found in the system.\n";
@@ -180,95 +181,44 @@ void UIAdmin::showSystemStatistics() {
     uiCore->clearScreen();
     cout << "=== SYSTEM STATISTICS ===\n\n";
     
-    // Get all data
-    vector<User> allUsers = auth->getAllUsers();
-    vector<Motorbike> allMotorbikes = bookingManager->getAllMotorbikes();
-    vector<Booking> allBookings = bookingManager->getAllBookings();
-    
-    // Calculate statistics
-    int totalUsers = allUsers.size();
-    int memberCount = 0;
-    int adminCount = 0;
-    double totalCreditPoints = 0.0;
-    double averageRating = 0.0;
-    
-    for (const User& user : allUsers) {
-        if (user.getRole() == "member") {
-            memberCount++;
-            totalCreditPoints += user.getCreditPoints();
-            averageRating += user.getRating();
-        } else if (user.getRole() == "admin") {
-            adminCount++;
-        }
-    }
-    
-    int totalMotorbikes = allMotorbikes.size();
-    int listedMotorbikes = 0;
-    int availableMotorbikes = 0;
-    double totalMotorbikeValue = 0.0;
-    double averageMotorbikeRating = 0.0;
-    
-    for (const Motorbike& motorbike : allMotorbikes) {
-        if (motorbike.getIsListed()) {
-            listedMotorbikes++;
-            totalMotorbikeValue += motorbike.getPricePerDay();
-        }
-        if (motorbike.getIsAvailable()) {
-            availableMotorbikes++;
-        }
-        averageMotorbikeRating += motorbike.getRating();
-    }
-    
-    int totalBookings = allBookings.size();
-    int pendingBookings = 0;
-    int approvedBookings = 0;
-    int completedBookings = 0;
-    int rejectedBookings = 0;
-    double totalBookingValue = 0.0;
-    
-    for (const Booking& booking : allBookings) {
-        if (booking.getStatus() == "Pending") pendingBookings++;
-        else if (booking.getStatus() == "Approved") approvedBookings++;
-        else if (booking.getStatus() == "Completed") completedBookings++;
-        else if (booking.getStatus() == "Rejected") rejectedBookings++;
-        
-        totalBookingValue += booking.getTotalCost();
-    }
+    SystemStatistics stats = collectStatistics(*auth, *bookingManager);
     
     // Display statistics
     cout << "=== USER STATISTICS ===\n";
-    cout << "Total Users: " << totalUsers << "\n";
-    cout << "Members: " << memberCount << "\n";
-    cout << "Admins: " << adminCount << "\n";
-    cout << "Total Credit Points: " << fixed << setprecision(0) << totalCreditPoints << " CP\n";
-    if (memberCount > 0) {
-        cout << "Average Member Rating: " << fixed << setprecision(1) << (averageRating / memberCount) << "/5.0\n";
+    cout << "Total Users: " << stats.totalUsers << "\n";
+    cout << "Members: " << stats.members << "\n";
+    cout << "Admins: " << stats.admins << "\n";
+    cout << "Total Credit Points: " << fixed << setprecision(0) << stats.totalCreditPoints << " CP\n";
+    if (stats.members > 0) {
+        cout << "Average Member Rating: " << fixed << setprecision(1) << stats.averageMemberRating << "/5.0\n";
     }
     
     cout << "\n=== MOTORBIKE STATISTICS ===\n";
-    cout << "Total Motorbikes: " << totalMotorbikes << "\n";
-    cout << "Listed Motorbikes: " << listedMotorbikes << "\n";
-    cout << "Available Motorbikes: " << availableMotorbikes << "\n";
-    cout << "Total Daily Value: " << fixed << setprecision(0) << totalMotorbikeValue << " CP\n";
-    if (totalMotorbikes > 0) {
-        cout << "Average Motorbike Rating: " << fixed << setprecision(1) << (averageMotorbikeRating / totalMotorbikes) << "/5.0\n";
+    cout << "Total Motorbikes: " << stats.totalMotorbikes << "\n";
+    cout << "Listed Motorbikes: " << stats.listedMotorbikes << "\n";
+    cout << "Available Motorbikes: " << stats.availableMotorbikes << "\n";
+    cout << "Total Daily Value: " << fixed << setprecision(0) << stats.totalDailyValue << " CP\n";
+    if (stats.totalMotorbikes > 0) {
+        cout << "Average Motorbike Rating: " << fixed << setprecision(1) << stats.averageMotorbikeRating << "/5.0\n";
     }
     
     cout << "\n=== BOOKING STATISTICS ===\n";
-    cout << "Total Bookings: " << totalBookings << "\n";
-    cout << "Pending Bookings: " << pendingBookings << "\n";
-    cout << "Approved Bookings: " << approvedBookings << "\n";
-    cout << "Completed Bookings: " << completedBookings << "\n";
-    cout << "Rejected Bookings: " << rejectedBookings << "\n";
-    cout << "Total Booking Value: " << fixed << setprecision(0) << totalBookingValue << " CP\n";
+    cout << "Total Bookings: " << stats.totalBookings << "\n";
+    cout << "Pending Bookings: " << stats.pendingBookings << "\n";
+    cout << "Approved Bookings: " << stats.approvedBookings << "\n";
+    cout << "Completed Bookings: " << stats.completedBookings << "\n";
+    cout << "Rejected Bookings: " << stats.rejectedBookings << "\n";
+    cout << "Total Booking Value: " << fixed << setprecision(0) << stats.totalBookingValue << " CP\n";
     
     cout << "\n=== SYSTEM OVERVIEW ===\n";
-    if (totalMotorbikes > 0) {
-        cout << "System Utilization: " << fixed << setprecision(1) << ((double)listedMotorbikes / totalMotorbikes * 100) << "%\n";
+    if (stats.totalMotorbikes > 0) {
+        cout << "System Utilization: " << fixed << setprecision(1) << ((double)stats.listedMotorbikes / stats.totalMotorbikes * 100) << "%\n";
     }
-    if (totalBookings > 0) {
-        cout << "Booking Success Rate: " << fixed << setprecision(1) << ((double)approvedBookings / totalBookings * 100) << "%\n";
+    if (stats.totalBookings > 0) {
+        cout << "Booking Success Rate: " << fixed << setprecision(1) << ((double)stats.approvedBookings / stats.totalBookings * 100) << "%\n";
     }
+    cout << "Search Cache: " << stats.searchCache.hits << " hits, " << stats.searchCache.misses << " misses, "
+         << stats.searchCache.invalidations << " invalidated (" << stats.searchCache.entries << " cached searches)\n";
     
     uiCore->pauseScreen();
 }
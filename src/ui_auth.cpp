@@ -0,0 +1,244 @@
+/**
+ * E-MOTORBIKE RENTAL APPLICATION
+ * Authentication UI Implementation
+ * 
+ * This file implements the UIAuth class methods for reading login and
+ * registration details from the console.
+ * 
+ * @author Group 5 - EEET2482/EEET2653/COSC2082/COSC2721
+ * @version 1.0
+ * @date Semester 2 2025
+ */
+
+#include "ui_auth.h"
+#include "auth.h"
+#include <iostream>
+#include <string>
+#include <limits>
+#include <cctype>
+
+#ifdef _WIN32
+#include <conio.h>
+#else
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * Constructor
+ */
+UIAuth::UIAuth() : auth(nullptr) {
+}
+
+/**
+ * Destructor
+ */
+UIAuth::~UIAuth() {
+    // Note: We don't delete the pointers as they are managed externally
+}
+
+/**
+ * Prompts for member credentials and logs the member in.
+ */
+bool UIAuth::memberLogin() {
+    if (!auth) {
+        return false;
+    }
+    
+    string username, password;
+    
+    cout << "\n=== MEMBER LOGIN ===" << endl;
+    cout << "Username: ";
+    cin >> username;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    
+    cout << "Password: ";
+    password = hidePassword();
+    cout << endl;
+    
+    return auth->login(username, password);
+}
+
+/**
+ * Prompts for admin credentials and logs the admin in.
+ */
+bool UIAuth::adminLogin() {
+    if (!auth) {
+        return false;
+    }
+    
+    string username, password;
+    
+    cout << "\n=== ADMIN LOGIN ===" << endl;
+    cout << "Username: ";
+    cin >> username;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    
+    cout << "Password: ";
+    password = hidePassword();
+    cout << endl;
+    
+    return auth->adminLogin(username, password);
+}
+
+/**
+ * Walks a new member through registration. Each field is checked as soon as
+ * it is entered, and the account is only created once the fee is accepted.
+ */
+bool UIAuth::registerUser() {
+    if (!auth) {
+        return false;
+    }
+    
+    string username, password, fullName, email, phone;
+    
+    cout << "\n=== USER REGISTRATION ===" << endl;
+    cout << "Username: ";
+    cin >> username;
+    
+    // Check if username already exists
+    if (auth->getUser(username)) {
+        cout << "Username already exists. Please choose a different username." << endl;
+        return false;
+    }
+    
+    cout << "Password: ";
+    cin.ignore();
+    password = hidePassword();
+    cout << endl;
+    
+    // Validate password strength
+    if (!auth->validatePassword(password)) {
+        cout << "Registration failed due to weak password." << endl;
+        return false;
+    }
+    
+    cout << "Full Name: ";
+    getline(cin, fullName);
+    
+    cout << "Email: ";
+    getline(cin, email);
+    
+    // Validate email
+    if (!auth->validateEmail(email)) {
+        cout << "Registration failed due to invalid email." << endl;
+        return false;
+    }
+    
+    cout << "Phone Number: ";
+    getline(cin, phone);
+    
+    // Validate phone number
+    if (!auth->validatePhoneNumber(phone)) {
+        cout << "Registration failed due to invalid phone number." << endl;
+        return false;
+    }
+    
+    string idType, idNumber, licenseNumber, licenseExpiry;
+    
+    cout << "ID Type (Citizen ID or Passport): ";
+    getline(cin, idType);
+    
+    // Validate ID type
+    if (idType != "Citizen ID" && idType != "Passport") {
+        cout << "Invalid ID type. Must be 'Citizen ID' or 'Passport'." << endl;
+        cout << "Registration failed." << endl;
+        return false;
+    }
+    
+    cout << "ID Number: ";
+    getline(cin, idNumber);
+    
+    // Validate ID number is not empty
+    if (idNumber.empty()) {
+        cout << "ID Number cannot be empty." << endl;
+        cout << "Registration failed." << endl;
+        return false;
+    }
+    
+    cout << "Driver's License Number (optional, press Enter to skip): ";
+    getline(cin, licenseNumber);
+    
+    if (!licenseNumber.empty()) {
+        cout << "License Expiry Date (DD/MM/YYYY): ";
+        getline(cin, licenseExpiry);
+    }
+    
+    cout << "\n=== REGISTRATION FEE ===" << endl;
+    cout << "A $20 registration fee is required to complete registration." << endl;
+    cout << "Upon payment, you will receive 20 Credit Points and a default rating of 3.0." << endl;
+    cout << "Proceed with payment? (y/n): ";
+    
+    char payChoice;
+    cin >> payChoice;
+    
+    if (tolower(payChoice) != 'y') {
+        cout << "Registration cancelled. No payment processed." << endl;
+        return false;
+    }
+    
+    if (!auth->registerUser(username, password, fullName, email, phone, idType, idNumber,
+                            licenseNumber, licenseExpiry)) {
+        cout << "Registration failed." << endl;
+        return false;
+    }
+    
+    cout << "Processing payment of $20..." << endl;
+    cout << "Payment successful!" << endl;
+    cout << "Registration completed! Welcome, " << fullName << "!" << endl;
+    cout << "You have received 20 Credit Points and a default renter rating of 3.0." << endl;
+    cout << "You can now login with your credentials." << endl;
+    
+    return true;
+}
+
+/**
+ * Reads a password character by character without echoing it. Uses _getch
+ * on Windows and switches the terminal out of echo/line mode elsewhere; when
+ * input is not a terminal (scripted runs) it reads the line as is.
+ */
+string UIAuth::hidePassword() {
+    string password;
+#ifdef _WIN32
+    char ch;
+    while ((ch = _getch()) != '\r') { // '\r' is Enter key
+        if (ch == '\b') { // Backspace
+            if (!password.empty()) {
+                password.pop_back();
+                cout << "\b \b";
+            }
+        } else {
+            password += ch;
+            cout << '*';
+        }
+    }
+#else
+    termios saved;
+    bool terminal = tcgetattr(STDIN_FILENO, &saved) == 0;
+    if (terminal) {
+        termios hidden = saved;
+        hidden.c_lflag &= ~(ICANON | ECHO);
+        tcsetattr(STDIN_FILENO, TCSANOW, &hidden);
+    }
+    
+    int ch;
+    while ((ch = cin.get()) != EOF && ch != '\n' && ch != '\r') {
+        if (ch == '\b' || ch == 127) { // Backspace or Delete
+            if (!password.empty()) {
+                password.pop_back();
+                cout << "\b \b" << flush;
+            }
+        } else {
+            password += static_cast<char>(ch);
+            cout << '*' << flush;
+        }
+    }
+    
+    if (terminal) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+    }
+#endif
+    return password;
+}
@@ -151,7 +151,7 @@ void UIBooking::viewCompletedRentals() {
     vector<Booking> completedBookings;
     
     for (const Booking& booking : userBookings) {
-        if (booking.getStatus() == "Completed") {
+        if (booking.isCompleted()) {
             completedBookings.push_back(booking);
         }
     }
@@ -240,7 +240,7 @@ void UIBooking::viewApprovedRentals() {
     vector<Booking> approvedBookings;
     
     for (const Booking& booking : userBookings) {
-        if (booking.getStatus() == "Approved") {
+        if (booking.isApproved()) {
             approvedBookings.push_back(booking);
         }
     }
@@ -371,11 +371,9 @@ void UIBooking::viewCompletedRentalsForOwner() {
     cout << "=== COMPLETED RENTALS (AS OWNER) ===\n";
     
     // Get all bookings where this user is the owner and status is Completed
-    vector<Booking> allBookings = bookingManager->getAllBookings();
     vector<Booking> completedOwnerBookings;
-    
-    for (const Booking& booking : allBookings) {
-        if (booking.getOwnerUsername() == username && booking.getStatus() == "Completed") {
+    for (const Booking& booking : bookingManager->viewBookings()) {
+        if (booking.getOwnerUsername() == username && booking.isCompleted()) {
             completedOwnerBookings.push_back(booking);
         }
     }
@@ -93,7 +93,8 @@ void UICore::showGuestMenu() {
         cout << "=== GUEST MENU ===\n";
         cout << "1. View motorbike listings\n";
         cout << "2. Search motorbikes\n";
-        cout << "3. Back to main menu\n";
+        cout << "3. Search motorbikes by keyword\n";
+        cout << "4. Back to main menu\n";
         cout << "Enter your choice: ";
         
         cin >> choice;
@@ -106,12 +107,15 @@ void UICore::showGuestMenu() {
                 uiGuest->searchGuestMotorbikes();
                 break;
             case 3:
+                uiGuest->searchGuestMotorbikesByKeyword();
+                break;
+            case 4:
                 return;
             default:
                 cout << "Invalid choice.\n";
                 pauseScreen();
         }
-    } while (choice != 3);
+    } while (choice != 4);
 }
 
 /**
@@ -70,7 +70,6 @@ void UIDashboard::showActivityDashboard() {
     // Active rental bookings (as renter)
     cout << "Your active rental booking\n";
     cout << string(30, '-') << "\n";
-    vector<Booking> userBookings = bookingManager->getUserBookings(username);
     bool hasActive = false;
     cout << left
          << setw(18) << "Rent Period" << " | "
@@ -82,8 +81,8 @@ void UIDashboard::showActivityDashboard() {
          << setw(10) << "Owner" << " | "
          << "Status" << "\n";
     
-    for (const Booking& b : userBookings) {
-        if (b.getStatus() == "Approved") {
+    bookingManager->forEachUserBooking(username, [&](const Booking& b) {
+        if (b.isApproved()) {
             hasActive = true;
             cout << setw(18) << (b.getStartDate() + "-" + b.getEndDate()) << " | "
                  << setw(6)  << b.getBrand() << " | "
@@ -94,7 +93,7 @@ void UIDashboard::showActivityDashboard() {
                  << setw(10) << b.getOwnerUsername() << " | "
                  << b.getStatus() << "\n";
         }
-    }
+    });
     if (!hasActive) {
         cout << "No active rentals found." << "\n";
     }
@@ -103,21 +102,20 @@ void UIDashboard::showActivityDashboard() {
     // Active rental requests (as owner)
     cout << "Your active rental requests\n";
     cout << string(30, '-') << "\n";
-    vector<Booking> rentalRequests = bookingManager->getUserRentalRequests(username);
     bool hasRequests = false;
     cout << left
          << setw(18) << "Rent period" << " | "
          << setw(13) << "Renter rating" << " | "
          << "Renter" << "\n";
-    for (const Booking& req : rentalRequests) {
-        if (req.getStatus() == "Pending") {
+    bookingManager->forEachRentalRequest(username, [&](const Booking& req) {
+        if (req.isPending()) {
             hasRequests = true;
             double renterReqRating = auth->getUserRenterRating(req.getRenterUsername());
             cout << setw(18) << (req.getStartDate() + "-" + req.getEndDate()) << " | "
                  << setw(13) << fixed << setprecision(1) << renterReqRating << " | "
                  << req.getRenterUsername() << "\n";
         }
-    }
+    });
     if (!hasRequests) {
         cout << "No pending rental requests found." << "\n";
     }
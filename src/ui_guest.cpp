@@ -49,7 +49,7 @@ void UIGuest::viewGuestMotorbikeListings() {
     cout << "Note: As a guest, you can only view basic information.\n";
     cout << "Register as a member to see full details and make bookings.\n\n";
     
-    vector<Motorbike> guestMotorbikes = bookingManager->getGuestMotorbikes();
+    BookingManager::MotorbikeRange guestMotorbikes = bookingManager->viewGuestMotorbikes();
     
     if (guestMotorbikes.empty()) {
         cout << "No motorbikes available for viewing.\n";
@@ -109,22 +109,19 @@ void UIGuest::searchGuestMotorbikes() {
         return;
     }
     
-    // Get all guest motorbikes and filter by city
-    vector<Motorbike> allGuestMotorbikes = bookingManager->getGuestMotorbikes();
-    vector<Motorbike> filteredMotorbikes;
-    
-    for (const Motorbike& motorbike : allGuestMotorbikes) {
-        if (motorbike.getLocation() == city) {
-            filteredMotorbikes.push_back(motorbike);
-        }
-    }
+    // Listed motorbikes in the city, read in place
+    uint32_t cityId = fieldPool().find(city);
+    auto filteredMotorbikes = bookingManager->viewMotorbikes().where([cityId](const Motorbike& motorbike) {
+        return motorbike.getIsListed() && motorbike.getLocationId() == cityId;
+    });
+    size_t matchCount = filteredMotorbikes.count();
     
     // Display results
     uiCore->clearScreen();
     cout << "=== SEARCH RESULTS FOR " << city << " ===\n";
-    cout << "Found " << filteredMotorbikes.size() << " motorbike(s) in " << city << "\n\n";
+    cout << "Found " << matchCount << " motorbike(s) in " << city << "\n\n";
     
-    if (filteredMotorbikes.empty()) {
+    if (matchCount == 0) {
         cout << "No motorbikes found in " << city << ".\n";
     } else {
         // Display header with limited information
@@ -152,3 +149,52 @@ void UIGuest::searchGuestMotorbikes() {
     
     uiCore->pauseScreen();
 }
+
+/**
+ * Allows guests to search listed motorbikes by keyword.
+ * Matches brand, model, description and review text, best match first,
+ * showing the same basic details as the city search.
+ */
+void UIGuest::searchGuestMotorbikesByKeyword() {
+    if (!bookingManager || !uiCore) {
+        cout << "Error: Required components not available.\n";
+        if (uiCore) uiCore->pauseScreen();
+        return;
+    }
+    
+    uiCore->clearScreen();
+    cout << "=== GUEST KEYWORD SEARCH ===\n";
+    
+    string keywords;
+    cout << "Enter keywords (e.g. VinFast smooth city): ";
+    cin.ignore();
+    getline(cin, keywords);
+    
+    vector<Motorbike> results = bookingManager->searchMotorbikesByKeyword(keywords);
+    
+    // Display results
+    uiCore->clearScreen();
+    cout << "=== KEYWORD SEARCH RESULTS ===\n";
+    cout << "Keywords: " << keywords << "\n";
+    cout << "Found " << results.size() << " listed motorbike(s), best match first\n\n";
+    
+    if (results.empty()) {
+        cout << "No listed motorbikes match these keywords.\n";
+    } else {
+        // Display header with limited information
+        cout << setw(20) << left << "Brand/Model" << " | "
+             << setw(8) << "Size" << " | "
+             << setw(8) << "Location" << "\n";
+        cout << string(40, '-') << "\n";
+        
+        for (const Motorbike& motorbike : results) {
+            cout << setw(20) << left << (motorbike.getBrand() + " " + motorbike.getModel()) << " | "
+                 << setw(8) << motorbike.getSize() << " | "
+                 << setw(8) << motorbike.getLocation() << "\n";
+        }
+    }
+    
+    cout << "\nRegister as a member to see full details and make bookings.\n";
+    
+    uiCore->pauseScreen();
+}
@@ -19,6 +19,7 @@
 #include <limits>
 #include <cctype>
 #include <iomanip>
+#include <cstdlib>
 
 using namespace std;
 
@@ -244,7 +245,8 @@ void UIMotorbike::showMotorbikeSearchMenu() {
         uiCore->clearScreen();
         cout << "=== MOTORBIKE SEARCH MENU ===\n";
         cout << "1. Search Available Motorbikes\n";
-        cout << "2. Back to Member Menu\n";
+        cout << "2. Search by Keyword\n";
+        cout << "3. Back to Member Menu\n";
         cout << "Enter your choice: ";
         cin >> choice;
         
@@ -253,12 +255,15 @@ void UIMotorbike::showMotorbikeSearchMenu() {
                 searchMotorbikes();
                 break;
             case 2:
+                searchMotorbikesByKeyword();
+                break;
+            case 3:
                 return;
             default:
                 cout << "Invalid choice. Please try again.\n";
                 uiCore->pauseScreen();
         }
-    } while (choice != 2);
+    } while (choice != 3);
 }
 
 /**
@@ -315,33 +320,53 @@ void UIMotorbike::searchMotorbikes() {
         return;
     }
     
-    // Perform search
-    vector<Motorbike> results;
-    if (useDateRange) {
-        results = bookingManager->searchMotorbikesByDateRange(startDate, endDate, city, username, *auth);
-    } else {
-        results = bookingManager->searchMotorbikes(searchDate, city, username, *auth);
-    }
-    
-    // Display results
-    uiCore->clearScreen();
-    cout << "=== SEARCH RESULTS ===\n";
-    if (useDateRange) {
-        cout << "Date Range: " << startDate << " to " << endDate << "\n";
-    } else {
-        cout << "Search Date: " << searchDate << "\n";
-    }
-    cout << "City: " << city << "\n";
-    cout << "Found " << results.size() << " available motorbike(s)\n\n";
-    
-    if (results.empty()) {
-        cout << "No motorbikes found matching your criteria.\n";
-        cout << "This could be due to:\n";
-        cout << "- No motorbikes available in " << city << " on " << searchDate << "\n";
-        cout << "- Your rating doesn't meet the minimum requirements\n";
-        cout << "- Insufficient credit points\n";
-        cout << "- License requirements not met (for motorbikes > 50cc)\n";
-    } else {
+    cout << "Sort results by:\n";
+    cout << "1. Daily price (lowest first)\n";
+    cout << "2. Rating (highest first)\n";
+    cout << "3. Total cost for the period (lowest first)\n";
+    cout << "Enter your choice: ";
+    int sortChoice;
+    cin >> sortChoice;
+    
+    // Perform search one page at a time
+    SearchRequest request;
+    request.startDate = useDateRange ? startDate : searchDate;
+    request.endDate = useDateRange ? endDate : "";
+    request.city = city;
+    request.sortKey = sortChoice == 2 ? SearchSortKey::Rating :
+                      sortChoice == 3 ? SearchSortKey::TotalCost : SearchSortKey::Price;
+    request.limit = 20;
+    
+    size_t firstNumber = 1;
+    while (true) {
+        SearchPage page = bookingManager->searchMotorbikesPage(request, username, *auth);
+        const vector<Motorbike>& results = page.results;
+        
+        // Display results
+        uiCore->clearScreen();
+        cout << "=== SEARCH RESULTS ===\n";
+        if (useDateRange) {
+            cout << "Date Range: " << startDate << " to " << endDate << "\n";
+        } else {
+            cout << "Search Date: " << searchDate << "\n";
+        }
+        cout << "City: " << city << "\n";
+        cout << "Found " << page.totalMatches << " available motorbike(s)";
+        if (!results.empty()) {
+            cout << ", showing " << firstNumber << "-" << (firstNumber + results.size() - 1);
+        }
+        cout << "\n\n";
+        
+        if (results.empty()) {
+            cout << "No motorbikes found matching your criteria.\n";
+            cout << "This could be due to:\n";
+            cout << "- No motorbikes available in " << city << " on " << searchDate << "\n";
+            cout << "- Your rating doesn't meet the minimum requirements\n";
+            cout << "- Insufficient credit points\n";
+            cout << "- License requirements not met (for motorbikes > 50cc)\n";
+            break;
+        }
+        
         cout << "Available Motorbikes:\n";
         cout << "ID  | Brand/Model        | Color  | Size  | Plate No.    | Daily Rate | Rating | Min Rating | License\n";
         cout << "----|-------------------|--------|-------|--------------|------------|--------|------------|--------\n";
@@ -357,7 +382,7 @@ void UIMotorbike::searchMotorbikes() {
                 licenseStatus = "Not Required";
             }
             
-            cout << setw(3) << (i + 1) << " | "
+            cout << setw(3) << (firstNumber + i) << " | "
                  << setw(17) << (motorbike.getBrand() + " " + motorbike.getModel()) << " | "
                  << setw(6) << motorbike.getColor() << " | "
                  << setw(5) << motorbike.getSize() << " | "
@@ -368,13 +393,25 @@ void UIMotorbike::searchMotorbikes() {
                  << setw(6) << licenseStatus << "\n";
         }
         
-        // Option to view details
-        cout << "\nEnter motorbike number to view details (0 to go back): ";
-        int choice;
-        cin >> choice;
+        // Option to view details or move to the next page
+        cout << "\nEnter motorbike number to view details";
+        if (page.hasMore) {
+            cout << ", N for the next page";
+        }
+        cout << " (0 to go back): ";
+        string input;
+        cin >> input;
         
-        if (choice > 0 && choice <= static_cast<int>(results.size())) {
-            displayMotorbikeDetails(results[choice - 1]);
+        if (page.hasMore && (input == "N" || input == "n")) {
+            firstNumber += results.size();
+            request.after = page.next;
+            continue;
+        }
+        
+        int choice = atoi(input.c_str());
+        size_t index = static_cast<size_t>(choice) - firstNumber;
+        if (choice > 0 && static_cast<size_t>(choice) >= firstNumber && index < results.size()) {
+            displayMotorbikeDetails(results[index]);
             
             // Ask if user wants to make a rental request
             cout << "\nDo you want to make a rental request for this motorbike? (y/n): ";
@@ -382,18 +419,83 @@ void UIMotorbike::searchMotorbikes() {
             cin >> requestChoice;
             
             if (tolower(requestChoice) == 'y') {
-                makeRentalRequest(results[choice - 1]);
+                makeRentalRequest(results[index]);
             }
             
             // Details view already pauses; avoid a second pause here
             return;
         }
+        break;
     }
     
     // Pause only when not returning from details view
     uiCore->pauseScreen();
 }
 
+/**
+ * Handles keyword search over brand, model, description and review text.
+ * Results are ranked by relevance rather than filtered by date or city.
+ */
+void UIMotorbike::searchMotorbikesByKeyword() {
+    if (!auth || !auth->getCurrentUser() || !bookingManager || !uiCore) {
+        cout << "Error: Required components not available.\n";
+        if (uiCore) uiCore->pauseScreen();
+        return;
+    }
+    
+    uiCore->clearScreen();
+    cout << "=== KEYWORD SEARCH ===\n";
+    
+    string keywords;
+    cout << "Enter keywords (e.g. VinFast smooth city): ";
+    cin.ignore();
+    getline(cin, keywords);
+    
+    vector<Motorbike> results = bookingManager->searchMotorbikesByKeyword(keywords);
+    
+    uiCore->clearScreen();
+    cout << "=== KEYWORD SEARCH RESULTS ===\n";
+    cout << "Keywords: " << keywords << "\n";
+    cout << "Found " << results.size() << " listed motorbike(s), best match first\n\n";
+    
+    if (results.empty()) {
+        cout << "No listed motorbikes match these keywords.\n";
+        uiCore->pauseScreen();
+        return;
+    }
+    
+    cout << "No. | Brand/Model        | Size  | Location | Daily Rate | Rating\n";
+    cout << "----|-------------------|-------|----------|------------|-------\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Motorbike& motorbike = results[i];
+        cout << setw(3) << (i + 1) << " | "
+             << setw(17) << (motorbike.getBrand() + " " + motorbike.getModel()) << " | "
+             << setw(5) << motorbike.getSize() << " | "
+             << setw(8) << motorbike.getLocation() << " | "
+             << setw(7) << motorbike.getPricePerDay() << " CP | "
+             << fixed << setprecision(1) << motorbike.getRating() << "\n";
+    }
+    
+    cout << "\nEnter motorbike number to view details (0 to go back): ";
+    int choice;
+    cin >> choice;
+    
+    if (choice > 0 && choice <= static_cast<int>(results.size())) {
+        displayMotorbikeDetails(results[choice - 1]);
+        
+        cout << "\nDo you want to make a rental request for this motorbike? (y/n): ";
+        char requestChoice;
+        cin >> requestChoice;
+        
+        if (tolower(requestChoice) == 'y') {
+            makeRentalRequest(results[choice - 1]);
+        }
+        return;
+    }
+    
+    uiCore->pauseScreen();
+}
+
 /**
  * Displays detailed information about a specific motorbike.
  */
@@ -454,7 +556,19 @@ void UIMotorbike::displayMotorbikeReviews(const string& motorbikeId) {
     vector<string> reviews = bookingManager->getMotorbikeReviews(motorbikeId);
     double averageRating = bookingManager->getAverageRating(motorbikeId);
     
-    cout << "Average Rating: " << fixed << setprecision(1) << averageRating << "/5.0\n\n";
+    cout << "Average Rating: " << fixed << setprecision(1) << averageRating << "/5.0\n";
+    
+    if (!reviews.empty()) {
+        vector<int> distribution = bookingManager->getRatingDistribution(motorbikeId);
+        int reviewCount = bookingManager->getReviewCount(motorbikeId);
+        for (int star = 5; star >= 1; star--) {
+            int count = distribution[star - 1];
+            int barLength = reviewCount > 0 ? count * 20 / reviewCount : 0;
+            cout << star << " star | " << string(barLength, '#') << string(20 - barLength, ' ')
+                 << " | " << count << "\n";
+        }
+    }
+    cout << "\n";
     
     if (reviews.empty()) {
         cout << "No reviews available for this motorbike.\n";
@@ -12,6 +12,7 @@
 
 #include "ui_profile.h"
 #include "ui_core.h"
+#include "ui_auth.h"
 #include "auth.h"
 #include "booking.h"
 #include <iostream>
@@ -172,17 +173,17 @@ void UIProfile::changeUserPassword() {
     // Get current password for verification
     cout << "Enter current password: ";
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    oldPassword = auth->hidePassword();
+    oldPassword = UIAuth::hidePassword();
     cout << endl;
     
     // Get new password
     cout << "Enter new password: ";
-    newPassword = auth->hidePassword();
+    newPassword = UIAuth::hidePassword();
     cout << endl;
     
     // Confirm new password
     cout << "Confirm new password: ";
-    confirmPassword = auth->hidePassword();
+    confirmPassword = UIAuth::hidePassword();
     cout << endl;
     
     // Validate password confirmation
@@ -236,7 +237,7 @@ void UIProfile::topUpCreditPoints() {
     // Require password authentication for security
     cout << "Enter your password to confirm: ";
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    password = auth->hidePassword();
+    password = UIAuth::hidePassword();
     cout << endl;
     
     // Verify password before processing
@@ -0,0 +1,167 @@
+/**
+ * E-MOTORBIKE RENTAL APPLICATION
+ * HTTP Request Parser Checks
+ *
+ * Focused checks for parseHttpRequest, formValue and decodeBase64, which
+ * read untrusted network input: pipelining, framing headers, size limits,
+ * line endings and the edges of the two decoders.
+ *
+ * Run: ctest, or ./http_request_test (exit status is the failure count)
+ */
+
+#include "http_request.h"
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        cout << "FAILED: " << what << endl;
+        failures++;
+    }
+}
+
+static HttpParseStatus parse(const string& input, HttpRequest& request) {
+    return parseHttpRequest(input, request);
+}
+
+static HttpParseStatus parse(const string& input) {
+    HttpRequest request;
+    return parseHttpRequest(input, request);
+}
+
+static void checkPipelining() {
+    string first = "POST /bookings HTTP/1.1\r\nHost: x\r\nContent-Length: 5\r\n\r\nhello";
+    string second = "GET /motorbikes?city=HCMC HTTP/1.1\r\nHost: x\r\n\r\n";
+    string input = "\r\n\r\n" + first + "\r\n" + second;
+    HttpRequest request;
+    check(parse(input, request) == HttpParseStatus::Complete, "pipelined: first request complete");
+    check(request.method == "POST" && request.path == "/bookings", "pipelined: first request line");
+    check(request.body == "hello", "pipelined: first body");
+    check(request.length == 4 + first.size(), "pipelined: leading CRLFs counted in length");
+
+    string rest = input.substr(request.length);
+    check(parse(rest, request) == HttpParseStatus::Complete, "pipelined: second request after CRLF");
+    check(request.method == "GET" && request.path == "/motorbikes" && request.query == "city=HCMC",
+          "pipelined: second request line");
+    check(request.length == rest.size(), "pipelined: second request fills the rest");
+
+    check(parse("\r\n\r\n") == HttpParseStatus::Incomplete, "only CRLFs are incomplete");
+    check(parse(first.substr(0, first.size() - 1)) == HttpParseStatus::Incomplete, "short body is incomplete");
+}
+
+static void checkContentLength() {
+    string head = "POST /login HTTP/1.1\r\nHost: x\r\n";
+    check(parse(head + "Content-Length: 3\r\nContent-Length: 3\r\n\r\nabc") == HttpParseStatus::Complete,
+          "duplicate equal Content-Length accepted");
+    check(parse(head + "Content-Length: 3\r\nContent-Length: 4\r\n\r\nabcd") == HttpParseStatus::BadRequest,
+          "conflicting Content-Length rejected");
+    check(parse(head + "Content-Length: 3, 3\r\n\r\nabc") == HttpParseStatus::BadRequest,
+          "Content-Length list rejected");
+    check(parse(head + "Content-Length: -1\r\n\r\n") == HttpParseStatus::BadRequest,
+          "negative Content-Length rejected");
+    check(parse(head + "Content-Length:\r\n\r\n") == HttpParseStatus::BadRequest,
+          "empty Content-Length rejected");
+    check(parse(head + "Content-Length: 99999999999999999999999\r\n\r\n") == HttpParseStatus::BodyTooLarge,
+          "overflowing Content-Length is too large");
+}
+
+static void checkTransferEncoding() {
+    string head = "POST /login HTTP/1.1\r\nHost: x\r\n";
+    check(parse(head + "Transfer-Encoding: chunked\r\n\r\n3\r\nabc\r\n0\r\n\r\n") ==
+              HttpParseStatus::NotImplemented, "chunked body not implemented");
+    check(parse(head + "Content-Length: 3\r\ntransfer-encoding: chunked\r\n\r\nabc") ==
+              HttpParseStatus::NotImplemented, "Transfer-Encoding with Content-Length not implemented");
+}
+
+static void checkLimits() {
+    string line = "GET / HTTP/1.1\r\n";
+    string filler = "X-Filler: ";
+    string atLimit = line + filler + string(MAX_HTTP_HEAD_SIZE - line.size() - filler.size() - 2, 'a') + "\r\n";
+    check(parse(atLimit + "\r\n") == HttpParseStatus::Complete, "head of exactly 8 KiB accepted");
+    check(parse(line + filler + string(MAX_HTTP_HEAD_SIZE, 'a') + "\r\n\r\n") == HttpParseStatus::HeadersTooLarge,
+          "head over 8 KiB rejected");
+    check(parse(line + filler + string(MAX_HTTP_HEAD_SIZE, 'a')) == HttpParseStatus::HeadersTooLarge,
+          "unterminated head over 8 KiB rejected before the blank line");
+
+    string headers;
+    for (size_t i = 0; i <= MAX_HTTP_HEADERS; i++) {
+        headers += "X-" + to_string(i) + ": 1\r\n";
+    }
+    check(parse(line + headers + "\r\n") == HttpParseStatus::HeadersTooLarge, "too many headers rejected");
+
+    string head = "POST /login HTTP/1.1\r\nContent-Length: ";
+    string body(MAX_HTTP_BODY_SIZE, 'b');
+    check(parse(head + to_string(MAX_HTTP_BODY_SIZE) + "\r\n\r\n" + body) == HttpParseStatus::Complete,
+          "body of exactly 64 KiB accepted");
+    check(parse(head + to_string(MAX_HTTP_BODY_SIZE + 1) + "\r\n\r\n") == HttpParseStatus::BodyTooLarge,
+          "body over 64 KiB rejected before it arrives");
+}
+
+static void checkLineEndings() {
+    check(parse("GET / HTTP/1.1\nHost: x\n\n") == HttpParseStatus::BadRequest, "bare LF request rejected");
+    check(parse("GET / HTTP/1.1\n") == HttpParseStatus::BadRequest, "bare LF rejected before the blank line");
+    check(parse("GET / HTTP/1.1\r\nHost: x\n\r\n") == HttpParseStatus::BadRequest, "bare LF in a header rejected");
+    check(parse("\nGET / HTTP/1.1\r\n\r\n") == HttpParseStatus::BadRequest, "leading bare LF rejected");
+    check(parse("GET / HTTP/1.1\r\nHost: x\r\n") == HttpParseStatus::Incomplete, "CRLF head without blank line waits");
+    check(parse("POST / HTTP/1.1\r\nContent-Length: 2\r\n\r\n\n\n") == HttpParseStatus::Complete,
+          "LF inside the body is data");
+    check(parse("GET / HTTP/2.0\r\n\r\n") == HttpParseStatus::VersionNotSupported, "HTTP/2 not supported");
+    check(parse("GET / HTTP/1.1\r\n Folded: x\r\n\r\n") == HttpParseStatus::BadRequest, "folded header rejected");
+}
+
+static string form(const string& text, const string& name, bool* found = nullptr) {
+    string storage;
+    string_view value;
+    bool present = formValue(text, name, storage, value);
+    if (found) {
+        *found = present;
+    }
+    return string(value);
+}
+
+static void checkFormValue() {
+    check(form("a=1&b=2", "b") == "2", "plain value");
+    check(form("name=Tran+Van%20A", "name") == "Tran Van A", "plus and percent decoded");
+    check(form("x=%41", "x") == "A", "percent escape at the very end decoded");
+    check(form("x=a%4", "x") == "a%4", "truncated escape at the end kept literally");
+    check(form("x=a%", "x") == "a%", "lone percent at the end kept literally");
+    check(form("x=%zz", "x") == "%zz", "non-hex escape kept literally");
+    check(form("x=%00", "x") == string(1, '\0'), "escaped NUL decoded");
+    bool found = false;
+    check(form("x", "x", &found) == "" && found, "name without '=' is present and empty");
+    form("xy=1", "x", &found);
+    check(!found, "name prefix does not match");
+}
+
+static void checkBase64() {
+    string decoded;
+    check(decodeBase64("YWRtaW46QWRtaW4xMjMh", decoded) && decoded == "admin:Admin123!", "unpadded length 4n");
+    check(decodeBase64("YQ==", decoded) && decoded == "a", "two padding characters");
+    check(decodeBase64("YWI=", decoded) && decoded == "ab", "one padding character");
+    check(decodeBase64("", decoded) && decoded.empty(), "empty input");
+    check(!decodeBase64("YQ", decoded), "missing padding rejected");
+    check(!decodeBase64("YQ=", decoded), "short padding rejected");
+    check(!decodeBase64("YQ===", decoded), "extra padding rejected");
+    check(!decodeBase64("Y===", decoded), "three padding characters rejected");
+    check(!decodeBase64("====", decoded), "padding only rejected");
+    check(!decodeBase64("YQ=a", decoded), "data after padding rejected");
+    check(!decodeBase64("Y=Q=", decoded), "padding in the middle rejected");
+    check(!decodeBase64("YR==", decoded), "non-zero padded bits rejected");
+    check(!decodeBase64("YW*i", decoded), "invalid character rejected");
+}
+
+int main() {
+    checkPipelining();
+    checkContentLength();
+    checkTransferEncoding();
+    checkLimits();
+    checkLineEndings();
+    checkFormValue();
+    checkBase64();
+    cout << (failures == 0 ? "All HTTP request checks passed." : "HTTP request checks failed.") << endl;
+    return failures;
+}
@@ -0,0 +1,320 @@
+/**
+ * E-MOTORBIKE RENTAL APPLICATION
+ * Journal Recovery Checks
+ *
+ * Runs Auth and BookingManager on a temporary copy of the data/ text
+ * files. Each session runs in a child process that ends with _Exit, as a
+ * crash would, unless it shuts down on purpose; the next session reloads
+ * the files and checks the state: a bookings.txt row with a bad date is
+ * refused, the journal is replayed, a B|count group cut short is dropped,
+ * compaction carries K records over, and replayCredits merges account.log
+ * and bookings.log above the account.txt credit watermark. Last, a session
+ * started while another process holds data/.lock must refuse the files.
+ *
+ * Run: ctest, or ./journal_test <data directory> (exit status is the failure count)
+ */
+
+#include "auth.h"
+#include "booking.h"
+#include "booking_snapshot.h"
+#include "data_lock.h"
+#include "message_stream.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+static int failures = 0;
+static string scratch;  // Temporary directory the checks run in
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        cout << "FAILED: " << what << endl;
+        failures++;
+    }
+}
+
+static string readFile(const string& filename) {
+    ifstream file(filename, ios::binary);
+    ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+static void writeFile(const string& filename, const string& contents) {
+    ofstream(filename, ios::binary | ios::trunc) << contents;
+}
+
+// Copies the sample data into a fresh temporary directory and enters it,
+// since the engine opens data/... relative to the working directory
+static bool enterScratchCopy(const string& source) {
+    const char* names[] = {"account.txt", "bookings.txt", "motorbikes.txt", "reviews.txt"};
+    string contents[4];
+    for (size_t i = 0; i < 4; i++) {
+        contents[i] = readFile(source + "/" + names[i]);
+        if (contents[i].empty()) {
+            return false;
+        }
+    }
+    char directory[] = "/tmp/journal_test.XXXXXX";
+    if (!mkdtemp(directory) || chdir(directory) != 0 || mkdir("data", 0755) != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < 4; i++) {
+        writeFile(string("data/") + names[i], contents[i]);
+    }
+    scratch = directory;
+    return true;
+}
+
+// Runs one session in a child process. Unless body deletes them, auth and
+// manager are never destroyed: the child ends as if it had crashed.
+static void session(const function<void(Auth*&, BookingManager*&)>& body) {
+    cout.flush();
+    pid_t child = fork();
+    if (child == 0) {
+        failures = 0;
+        ostringstream messages;
+        ScopedMessageStream quiet(messages);
+        Auth* auth = new Auth();
+        BookingManager* manager = new BookingManager();
+        body(auth, manager);
+        cout.flush();
+        _Exit(failures);
+    }
+    int status = 0;
+    if (child < 0 || waitpid(child, &status, 0) != child || !WIFEXITED(status)) {
+        check(false, "session ran to the end");
+        return;
+    }
+    failures += WEXITSTATUS(status);
+}
+
+static const Booking* adminBooking(const BookingSnapshot& snapshot) {
+    for (const Booking& booking : snapshot.viewBookings()) {
+        if (booking.getRenterUsername() == "admin" && booking.getMotorbikeId() == "MB003") {
+            return &booking;
+        }
+    }
+    return nullptr;
+}
+
+static bool motorbikeAvailable(const BookingSnapshot& snapshot, const string& motorbikeId) {
+    for (const Motorbike& motorbike : snapshot.viewMotorbikes()) {
+        if (motorbike.getMotorbikeId() == motorbikeId) {
+            return motorbike.getIsAvailable();
+        }
+    }
+    return false;
+}
+
+// totalCost of admin's booking, the field after status in its record
+static double bookingCost() {
+    string records = readFile("data/bookings.txt") + readFile("data/bookings.log");
+    size_t field = records.find("|admin|tuanhaipham|MB003|");
+    for (int i = 0; i < 6 && field != string::npos; i++) {
+        field = records.find('|', field + 1);
+    }
+    return field == string::npos ? -1 : atof(records.c_str() + field + 1);
+}
+
+static bool hasLine(const string& contents, const string& prefix) {
+    return contents.compare(0, prefix.size(), prefix) == 0 || contents.find("\n" + prefix) != string::npos;
+}
+
+// A row whose dates do not parse is left out rather than loaded with
+// invalid dates, which saving would write back as empty fields
+static void checkInvalidDates() {
+    string bookings = readFile("data/bookings.txt");
+    writeFile("data/bookings.txt", bookings +
+              "BK999|ducthinhlu|soohyukjang|MB002|32/13/2025|02/10/2025|Pending|35|Honda|Air Blade|Blue|125cc|X\n");
+    session([](Auth*&, BookingManager*& manager) {
+        bool found = false, others = false;
+        for (const Booking& booking : manager->snapshot()->viewBookings()) {
+            found = found || booking.getBookingId() == "BK999";
+            others = others || booking.getBookingId() == "BK008";
+        }
+        check(!found && others, "invalid dates: row refused, the rest loaded");
+    });
+    writeFile("data/bookings.txt", bookings);
+}
+
+// admin (100 CP) tops up, requests MB003 from tuanhaipham and has it
+// approved, then the process dies; the approval's charge, status and
+// availability records are one B|count group at the end of bookings.log
+static void checkReplay() {
+    session([](Auth*& auth, BookingManager*& manager) {
+        check(auth->topUpCreditPoints("admin", 100), "top-up before the crash");
+        check(manager->createBooking("admin", "MB003", "01/10/2025", "02/10/2025", *auth), "booking request");
+        const Booking* booking = adminBooking(*manager->snapshot());
+        check(booking && manager->approveBooking(booking->getBookingId(), "tuanhaipham", *auth), "approval");
+    });
+    string journal = readFile("data/bookings.log");
+    check(hasLine(journal, "C|") && hasLine(journal, "B|"), "request and approval group journaled");
+    check(hasLine(readFile("data/account.log"), "K|"), "top-up journaled in account.log");
+    check(bookingCost() > 0, "booking cost found");
+
+    session([](Auth*& auth, BookingManager*& manager) {
+        Published<BookingSnapshot>::Pin snapshot = manager->snapshot();
+        const Booking* booking = adminBooking(*snapshot);
+        check(booking && booking->isApproved(), "replay: booking approved");
+        check(!motorbikeAvailable(*snapshot, "MB003"), "replay: motorbike unavailable");
+        check(auth->getUserCreditPoints("admin") == 200 - bookingCost(), "replay: top-up and charge applied");
+    });
+}
+
+// The approval group loses its last line and half of the one before, as a
+// crash part way through its write would leave it: none of it may apply
+static void checkTornGroup() {
+    string journal = readFile("data/bookings.log");
+    size_t lastLine = journal.rfind('\n', journal.size() - 2);
+    size_t cut = journal.rfind('\n', lastLine - 1) + 3;
+    writeFile("data/bookings.log", journal.substr(0, cut));
+
+    session([](Auth*& auth, BookingManager*& manager) {
+        Published<BookingSnapshot>::Pin snapshot = manager->snapshot();
+        const Booking* booking = adminBooking(*snapshot);
+        check(booking && booking->isPending(), "torn group: request kept, approval dropped");
+        check(motorbikeAvailable(*snapshot, "MB003"), "torn group: availability dropped");
+        check(auth->getUserCreditPoints("admin") == 200, "torn group: charge dropped");
+    });
+    writeFile("data/bookings.log", journal);
+}
+
+// A top-up after the approval lands in account.log with a higher change
+// number than the charge in bookings.log; replayCredits must take it
+static void checkCreditMerge() {
+    session([](Auth*& auth, BookingManager*&) {
+        check(auth->topUpCreditPoints("admin", 7), "second top-up");
+    });
+    session([](Auth*& auth, BookingManager*&) {
+        check(auth->getUserCreditPoints("admin") == 207 - bookingCost(), "merge: latest change of both journals");
+    });
+}
+
+// Compaction folds bookings.log into bookings.txt but must keep the charge
+// (a K record) while account.txt does not contain it yet
+static void checkCompactionCarriesCredits() {
+    session([](Auth*&, BookingManager*& manager) {
+        delete manager; // Compacts; Auth dies without saving account.txt
+        manager = nullptr;
+    });
+    string journal = readFile("data/bookings.log");
+    check(!hasLine(journal, "C|") && !hasLine(journal, "S|"), "compaction: booking records folded");
+    check(hasLine(journal, "K|"), "compaction: charge carried over");
+    check(readFile("data/bookings.txt").find("|admin|tuanhaipham|MB003|") != string::npos,
+          "compaction: booking in bookings.txt");
+
+    session([](Auth*& auth, BookingManager*& manager) {
+        const Booking* booking = adminBooking(*manager->snapshot());
+        check(booking && booking->isApproved(), "after compaction: booking approved");
+        check(auth->getUserCreditPoints("admin") == 207 - bookingCost(), "after compaction: credits");
+    });
+}
+
+// Saving account.txt records the last change it contains; the carried K
+// record is then older than that watermark and must not be applied again
+static void checkWatermark() {
+    session([](Auth*& auth, BookingManager*&) {
+        delete auth; // Writes account.txt; the manager dies without compacting
+        auth = nullptr;
+    });
+    check(hasLine(readFile("data/account.txt"), "# Credit changes: "), "watermark written");
+    check(hasLine(readFile("data/bookings.log"), "K|"), "old charge still in bookings.log");
+
+    // Overwrite admin's balance in account.txt: only a replayed record
+    // newer than the watermark could change it back
+    string accounts = readFile("data/account.txt");
+    size_t admin = accounts.find("\nadmin|");
+    size_t field = admin;
+    for (int i = 0; i < 10 && field != string::npos; i++) {
+        field = accounts.find('|', field + 1);
+    }
+    size_t end = field == string::npos ? field : accounts.find('|', field + 1);
+    check(end != string::npos, "admin balance field found");
+    if (end != string::npos) {
+        writeFile("data/account.txt", accounts.substr(0, field + 1) + "1234" + accounts.substr(end));
+    }
+    session([](Auth*& auth, BookingManager*&) {
+        check(auth->getUserCreditPoints("admin") == 1234, "watermark: older K records ignored");
+    });
+}
+
+// Another process holds data/.lock: Auth and BookingManager load nothing
+// and their destructors must leave every file as it was
+static void checkDataLock() {
+    int ready[2], release[2];
+    if (pipe(ready) != 0 || pipe(release) != 0) {
+        check(false, "lock holder pipes");
+        return;
+    }
+    cout.flush();
+    pid_t holder = fork();
+    if (holder == 0) {
+        DataLock lock;
+        char byte = lock.isHeld() ? 1 : 0;
+        (void)!write(ready[1], &byte, 1);
+        (void)!read(release[0], &byte, 1);
+        _Exit(0);
+    }
+    char held = 0;
+    check(holder > 0 && read(ready[0], &held, 1) == 1 && held, "first process takes data/.lock");
+
+    string accounts = readFile("data/account.txt");
+    string bookings = readFile("data/bookings.txt");
+    session([](Auth*& auth, BookingManager*& manager) {
+        check(!auth->hasDataLock() && !manager->hasDataLock(), "second process refused");
+        check(auth->getUserCreditPoints("admin") == 0, "second process loaded no accounts");
+        delete manager;
+        delete auth;
+        manager = nullptr;
+        auth = nullptr;
+    });
+    check(readFile("data/account.txt") == accounts && readFile("data/bookings.txt") == bookings,
+          "second process left the files alone");
+
+    char byte = 0;
+    (void)!write(release[1], &byte, 1);
+    if (holder > 0) {
+        waitpid(holder, nullptr, 0);
+    }
+    for (int fd : {ready[0], ready[1], release[0], release[1]}) {
+        close(fd);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || !enterScratchCopy(argv[1])) {
+        cout << "Usage: journal_test <data directory with account.txt, bookings.txt, motorbikes.txt, reviews.txt>"
+             << endl;
+        return 1;
+    }
+    checkInvalidDates();
+    checkReplay();
+    checkTornGroup();
+    checkCreditMerge();
+    checkCompactionCarriesCredits();
+    checkWatermark();
+    checkDataLock();
+    if (failures == 0) {
+        for (const char* name : {"account.txt", "account.log", "account.txt.tmp", "bookings.txt", "bookings.log",
+                                 "bookings.txt.tmp", "bookings.log.tmp", "motorbikes.txt", "motorbikes.txt.tmp",
+                                 "reviews.txt", ".lock"}) {
+            remove((string("data/") + name).c_str());
+        }
+        rmdir("data");
+        rmdir(scratch.c_str());
+    } else {
+        cout << "Files left in " << scratch << endl;
+    }
+    cout << (failures == 0 ? "All journal checks passed." : "Journal checks failed.") << endl;
+    return failures;
+}